@@ -0,0 +1,88 @@
+/*
+  Reading pressure, temperature and humidity from the MS8607 without blocking
+  By: SparkFun Electronics
+  License: MIT. See license file for more information but you can
+  basically do whatever you want with this code.
+
+  Feel like supporting open source hardware?
+  Buy a board from SparkFun!
+
+  read_temperature_pressure_humidity() waits for each conversion with delay(),
+  which stalls loop() for about 52ms at the highest resolution.
+
+  This example shows how to use startMeasurement(), isReady() and getResult()
+  instead. The library sequences the conversions itself each time you call
+  isReady() (or poll()), so loop() is free to do other work while the sensor
+  is converting.
+*/
+
+#include <Wire.h>
+
+#include <SparkFun_PHT_MS8607_Arduino_Library.h> // Click here to get the library: http://librarymanager/All#SparkFun_PHT_MS8607
+
+MS8607 barometricSensor;
+
+unsigned long otherWork = 0; // Counts how often loop() ran while the sensor was busy
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Serial.println("Qwiic PHT Sensor MS8607 Example");
+
+  Wire.begin();
+
+  if (barometricSensor.begin() == false)
+  {
+    Serial.println("MS8607 sensor did not respond. Trying again...");
+    if (barometricSensor.begin() == false)
+    {
+      Serial.println("MS8607 sensor did not respond. Please check wiring.");
+      while (1)
+        ;
+    }
+  }
+
+  //Let the humidity die convert while the pressure die converts D2 and D1.
+  //This cuts each measurement from about 52ms to about 36ms.
+  barometricSensor.set_acquisition_mode(MS8607_acquisition_pipelined);
+
+  barometricSensor.startMeasurement();
+}
+
+void loop(void)
+{
+  if (barometricSensor.isReady())
+  {
+    float temperature, pressure, humidity;
+    barometricSensor.getResult(&temperature, &pressure, &humidity);
+
+    Serial.print("Temperature=");
+    Serial.print(temperature, 1);
+    Serial.print("(C)");
+
+    Serial.print(" Pressure=");
+    Serial.print(pressure, 3);
+    Serial.print("(hPa or mbar)");
+
+    Serial.print(" Humidity=");
+    Serial.print(humidity, 1);
+    Serial.print("(%RH)");
+
+    Serial.print(" Loops while converting=");
+    Serial.print(otherWork);
+
+    Serial.println();
+
+    otherWork = 0;
+    barometricSensor.startMeasurement();
+  }
+  else if (barometricSensor.getAcquisitionState() == MS8607_acquisition_error)
+  {
+    Serial.println("Measurement failed. Restarting...");
+    barometricSensor.startMeasurement();
+  }
+  else
+  {
+    otherWork++; // Do something useful here
+  }
+}
@@ -0,0 +1,80 @@
+/*
+  Skipping the PROM reads on a warm boot
+  By: SparkFun Electronics
+  License: MIT. See license file for more information but you can
+  basically do whatever you want with this code.
+
+  Feel like supporting open source hardware?
+  Buy a board from SparkFun!
+
+  begin() normally reads the 7 calibration coefficients of the pressure die
+  one by one and checks their CRC. A node that wakes from deep sleep every
+  few seconds repeats this on every boot.
+
+  This example gives the library a PROM cache. The first begin() fills it.
+  Later calls to begin() take the coefficients from the cache after checking
+  its CRC, and read back two PROM words (the CRC and C1) to make sure the
+  same sensor is still attached. If the cache is bad or the sensor was swapped, begin()
+  falls back to the full PROM read and refreshes the cache.
+
+  On the ESP32, put the cache in RTC memory so it survives deep sleep:
+    RTC_DATA_ATTR MS8607_prom_cache promCache;
+  Use set_prom_cache_callbacks() to keep it in EEPROM or flash instead.
+*/
+
+#include <Wire.h>
+
+#include <SparkFun_PHT_MS8607_Arduino_Library.h> // Click here to get the library: http://librarymanager/All#SparkFun_PHT_MS8607
+
+MS8607 barometricSensor;
+
+MS8607_prom_cache promCache; // Starts empty. Use RTC memory to keep it across deep sleep.
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Serial.println("Qwiic PHT Sensor MS8607 Example");
+
+  Wire.begin();
+
+  //Use MS8607_prom_cache_trust to skip the read back as well, or
+  //MS8607_prom_cache_verify_serial to tie the cache to the serial number
+  barometricSensor.set_prom_cache(&promCache, MS8607_prom_cache_verify);
+}
+
+void loop(void)
+{
+  //Simulate a wake up from deep sleep
+  unsigned long start = micros();
+  bool ok = barometricSensor.begin();
+  unsigned long elapsed = micros() - start;
+
+  if (ok == false)
+  {
+    Serial.println("MS8607 sensor did not respond. Please check wiring.");
+  }
+  else
+  {
+    Serial.print("begin() took ");
+    Serial.print(elapsed);
+    Serial.print("us");
+    if (barometricSensor.prom_cache_hit())
+      Serial.print(" (coefficients from the cache)");
+    else
+      Serial.print(" (coefficients read from the sensor)");
+
+    uint64_t serial;
+    if (barometricSensor.readSerialNumber(&serial) == MS8607_status_ok)
+    {
+      Serial.print(" Serial=");
+      Serial.print((unsigned long)(serial >> 32), HEX);
+      Serial.print((unsigned long)(serial & 0xFFFFFFFF), HEX);
+    }
+
+    Serial.print(" Pressure=");
+    Serial.print(barometricSensor.getPressure(), 3);
+    Serial.println("(hPa or mbar)");
+  }
+
+  delay(1000);
+}
@@ -0,0 +1,190 @@
+/*
+  Checking and timing the CRC kernels
+  By: SparkFun Electronics
+  License: MIT. See license file for more information but you can
+  basically do whatever you want with this code.
+
+  Feel like supporting open source hardware?
+  Buy a board from SparkFun!
+
+  The library checks the CRC-8 of every humidity reading and the CRC-4 of the
+  pressure die PROM with lookup tables (see SparkFun_PHT_MS8607_CRC.h). This
+  example needs no sensor. It compares the byte and nibble table kernels with
+  the original bit loops from the TE driver:
+    - CRC-8 : every 1 and 2 byte input (all humidity words)
+    - CRC-4 : every value of every PROM word, the other words pseudo random
+  and then times each kernel.
+
+  The CRC-4 check runs the bit loop about a million times and takes a few
+  minutes on an 8-bit board.
+*/
+
+#include <SparkFun_PHT_MS8607_Arduino_Library.h> // Click here to get the library: http://librarymanager/All#SparkFun_PHT_MS8607
+
+// Original humidity CRC-8: 16 step bit loop over the value padded to 24 bits
+uint8_t reference_crc8(uint16_t value)
+{
+  uint32_t polynom = 0x988000; // x^8 + x^5 + x^4 + 1
+  uint32_t msb = 0x800000;
+  uint32_t mask = 0xFF8000;
+  uint32_t result = (uint32_t)value << 8;
+
+  while (msb != 0x80)
+  {
+    if (result & msb)
+      result = ((result ^ polynom) & mask) | (result & ~mask);
+    msb >>= 1;
+    mask >>= 1;
+    polynom >>= 1;
+  }
+  return result;
+}
+
+// Original PROM CRC-4 (AN520) on a copy of the 7 PROM words
+uint8_t reference_crc4(const uint16_t *prom)
+{
+  uint16_t n_prom[8];
+  uint16_t n_rem = 0;
+
+  for (uint8_t i = 0; i < 7; i++)
+    n_prom[i] = prom[i];
+  n_prom[7] = 0;
+  n_prom[0] &= 0x0FFF;
+
+  for (uint8_t cnt = 0; cnt < 16; cnt++)
+  {
+    if (cnt % 2 == 1)
+      n_rem ^= n_prom[cnt >> 1] & 0x00FF;
+    else
+      n_rem ^= n_prom[cnt >> 1] >> 8;
+    for (uint8_t n_bit = 8; n_bit > 0; n_bit--)
+    {
+      if (n_rem & 0x8000)
+        n_rem = (n_rem << 1) ^ 0x3000;
+      else
+        n_rem <<= 1;
+    }
+  }
+  return n_rem >> 12;
+}
+
+uint16_t lfsr = 0xACE1;
+
+uint16_t pseudo_random(void)
+{
+  lfsr = (lfsr >> 1) ^ (-(lfsr & 1u) & 0xB400u);
+  return lfsr;
+}
+
+unsigned long check_crc8(void)
+{
+  unsigned long errors = 0;
+  uint8_t data[2];
+
+  for (uint32_t value = 0; value < 0x10000; value++)
+  {
+    data[0] = value >> 8;
+    data[1] = value & 0xFF;
+    uint8_t expected = reference_crc8(value);
+    if (MS8607_crc8(data, 2) != expected)
+      errors++;
+    if (MS8607_crc8_nibble(data, 2) != expected)
+      errors++;
+    // Single bytes, e.g. the serial number, are the same as a leading zero
+    if ((value < 0x100) && ((MS8607_crc8(data + 1, 1) != expected) ||
+                            (MS8607_crc8_nibble(data + 1, 1) != expected)))
+      errors++;
+  }
+  return errors;
+}
+
+unsigned long check_crc4(void)
+{
+  unsigned long errors = 0;
+  uint16_t prom[7];
+
+  for (uint8_t word = 0; word < 7; word++)
+  {
+    for (uint32_t value = 0; value < 0x10000; value++)
+    {
+      for (uint8_t i = 0; i < 7; i++)
+        prom[i] = pseudo_random();
+      prom[word] = value;
+      uint8_t expected = reference_crc4(prom);
+      if (MS8607_crc4(prom) != expected)
+        errors++;
+      if (MS8607_crc4_nibble(prom) != expected)
+        errors++;
+    }
+  }
+  return errors;
+}
+
+volatile uint8_t sink;
+
+void print_time(const char *name, unsigned long start, unsigned int runs)
+{
+  unsigned long elapsed = micros() - start;
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print((float)elapsed / runs, 2);
+  Serial.println("us");
+}
+
+void benchmark(void)
+{
+  const unsigned int runs = 1000;
+  uint8_t data[2] = {0x68, 0x3A};
+  uint16_t prom[7] = {0x9002, 0x8BCA, 0x8A1D, 0x5F01, 0x4D75, 0x6F84, 0x6AD7};
+  unsigned long start;
+
+  start = micros();
+  for (unsigned int i = 0; i < runs; i++)
+    sink = reference_crc8((data[0] << 8) | data[1]);
+  print_time("CRC-8 bit loop     ", start, runs);
+
+  start = micros();
+  for (unsigned int i = 0; i < runs; i++)
+    sink = MS8607_crc8(data, 2);
+  print_time("CRC-8 byte table   ", start, runs);
+
+  start = micros();
+  for (unsigned int i = 0; i < runs; i++)
+    sink = MS8607_crc8_nibble(data, 2);
+  print_time("CRC-8 nibble table ", start, runs);
+
+  start = micros();
+  for (unsigned int i = 0; i < runs; i++)
+    sink = reference_crc4(prom);
+  print_time("CRC-4 bit loop     ", start, runs);
+
+  start = micros();
+  for (unsigned int i = 0; i < runs; i++)
+    sink = MS8607_crc4(prom);
+  print_time("CRC-4 byte table   ", start, runs);
+
+  start = micros();
+  for (unsigned int i = 0; i < runs; i++)
+    sink = MS8607_crc4_nibble(prom);
+  print_time("CRC-4 nibble table ", start, runs);
+}
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Serial.println("MS8607 CRC kernels");
+
+  unsigned long errors = check_crc8();
+  Serial.print("CRC-8 mismatches: ");
+  Serial.println(errors);
+
+  errors = check_crc4();
+  Serial.print("CRC-4 mismatches: ");
+  Serial.println(errors);
+
+  benchmark();
+}
+
+void loop(void)
+{
+}
@@ -0,0 +1,93 @@
+/*
+  Reading the MS8607 without floating point
+  By: SparkFun Electronics
+  License: MIT. See license file for more information but you can
+  basically do whatever you want with this code.
+
+  Feel like supporting open source hardware?
+  Buy a board from SparkFun!
+
+  read_temperature_pressure_humidity_fixed() returns:
+    - temperature in 0.01 degC (2512 = 25.12C)
+    - pressure in Pa (101325 = 1013.25mbar)
+    - humidity in 0.01 %RH (4537 = 45.37%)
+  The compensation only uses 32-bit integer arithmetic and gives exactly the
+  same values as the datasheet algorithm. On boards without an FPU (AVR,
+  Cortex-M0) it is much faster than the float API, and a sketch that only
+  uses the integer API does not link the floating point library at all.
+
+  This sketch prints the values with integer arithmetic only.
+
+  Hardware Connections:
+  Attach a Qwiic shield to your RedBoard or Uno.
+  Plug the Qwiic sensor into any port.
+  Serial.print it out at 115200 baud to serial monitor.
+*/
+
+#include <Wire.h>
+
+#include <SparkFun_PHT_MS8607_Arduino_Library.h> // Click here to get the library: http://librarymanager/All#SparkFun_PHT_MS8607
+
+MS8607 barometricSensor;
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Serial.println("Qwiic PHT Sensor MS8607 Example");
+
+  Wire.begin();
+
+  if (barometricSensor.begin() == false)
+  {
+    Serial.println("MS8607 sensor did not respond. Trying again...");
+    if (barometricSensor.begin() == false)
+    {
+      Serial.println("MS8607 sensor did not respond. Please check wiring.");
+      while (1)
+        ;
+    }
+  }
+}
+
+// Print a value in hundredths with two decimals
+void printHundredths(int32_t value)
+{
+  if (value < 0)
+  {
+    Serial.print("-");
+    value = -value;
+  }
+  Serial.print(value / 100);
+  Serial.print(".");
+  if (value % 100 < 10)
+    Serial.print("0");
+  Serial.print(value % 100);
+}
+
+void loop(void)
+{
+  int32_t temperature, pressure, humidity;
+
+  if (barometricSensor.read_temperature_pressure_humidity_fixed(&temperature, &pressure, &humidity) != MS8607_status_ok)
+  {
+    Serial.println("Read failed");
+  }
+  else
+  {
+    Serial.print("Temperature=");
+    printHundredths(temperature);
+    Serial.print("(C)");
+
+    Serial.print(" Pressure=");
+    printHundredths(pressure); // Pa = 0.01 mbar
+    Serial.print("(hPa or mbar)");
+
+    Serial.print(" Humidity=");
+    printHundredths(humidity);
+    Serial.print("(%RH)");
+
+    Serial.println();
+  }
+
+  delay(500);
+}
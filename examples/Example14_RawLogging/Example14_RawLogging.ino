@@ -0,0 +1,90 @@
+/*
+  Logging raw MS8607 samples for offline compensation
+  By: SparkFun Electronics
+  License: MIT. See license file for more information but you can
+  basically do whatever you want with this code.
+
+  Feel like supporting open source hardware?
+  Buy a board from SparkFun!
+
+  read_raw() returns the ADC words of the sensor (24-bit D1 pressure and
+  D2 temperature, 16-bit humidity) without compensating them, so a logger
+  spends no CPU time on the math and stores 10 bytes per sample. The
+  calibration coefficients are printed once, when the sketch starts. On a
+  PC, MS8607_compensate_temperature(), _pressure() and _humidity() (or
+  MS8607_compensate_batch() for a whole log) turn the records into exactly
+  the values the driver would have returned.
+
+  With set_temperature_refresh() D2 is only converted every few samples;
+  the records then repeat the last D2 value.
+
+  Output, CSV:
+    PROM,<word 0>,<C1>,...,<C6>
+    <millis>,<D1>,<D2>,<RH>
+
+  Hardware Connections:
+  Attach a Qwiic shield to your RedBoard or Uno.
+  Plug the Qwiic sensor into any port.
+  Serial.print it out at 115200 baud to serial monitor.
+*/
+
+#include <Wire.h>
+
+#include <SparkFun_PHT_MS8607_Arduino_Library.h> // Click here to get the library: http://librarymanager/All#SparkFun_PHT_MS8607
+
+MS8607 barometricSensor;
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Serial.println("Qwiic PHT Sensor MS8607 Example");
+
+  Wire.begin();
+
+  if (barometricSensor.begin() == false)
+  {
+    Serial.println("MS8607 sensor did not respond. Trying again...");
+    if (barometricSensor.begin() == false)
+    {
+      Serial.println("MS8607 sensor did not respond. Please check wiring.");
+      while (1)
+        ;
+    }
+  }
+
+  // Convert D2 every 8th pressure sample only
+  barometricSensor.set_temperature_refresh(8);
+
+  uint16_t coeff[7];
+  barometricSensor.get_prom_coefficients(coeff);
+
+  Serial.print("PROM");
+  for (uint8_t i = 0; i < 7; i++)
+  {
+    Serial.print(",");
+    Serial.print(coeff[i]);
+  }
+  Serial.println();
+}
+
+void loop(void)
+{
+  struct MS8607_raw_sample raw;
+
+  if (barometricSensor.read_raw(&raw) != MS8607_status_ok)
+  {
+    Serial.println("Read failed");
+  }
+  else
+  {
+    Serial.print(millis());
+    Serial.print(",");
+    Serial.print(raw.adc_pressure);
+    Serial.print(",");
+    Serial.print(raw.adc_temperature);
+    Serial.print(",");
+    Serial.println(raw.adc_humidity);
+  }
+
+  delay(500);
+}
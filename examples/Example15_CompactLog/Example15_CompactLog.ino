@@ -0,0 +1,133 @@
+/*
+  Logging the MS8607 in a compact binary format
+  By: SparkFun Electronics
+  License: MIT. See license file for more information but you can
+  basically do whatever you want with this code.
+
+  Feel like supporting open source hardware?
+  Buy a board from SparkFun!
+
+  A CSV line of temperature, pressure and humidity takes about 30 bytes.
+  MS8607_record_encode() stores the integer values as deltas from the
+  previous sample in zig-zag varints: a sample usually takes 4 bytes. A
+  keyframe with the PROM coefficients, the time and the absolute values
+  starts every page, so each page can be decoded on its own.
+
+  This sketch fills a 256 byte page in RAM (an SD card block or a flash page
+  on a real logger). When the page is full it prints its statistics, decodes
+  it to check it, and starts a new page with a keyframe.
+  extras/host/record_decode.cpp converts a log file back to CSV on a PC.
+
+  Hardware Connections:
+  Attach a Qwiic shield to your RedBoard or Uno.
+  Plug the Qwiic sensor into any port.
+  Serial.print it out at 115200 baud to serial monitor.
+*/
+
+#include <Wire.h>
+
+#include <SparkFun_PHT_MS8607_Arduino_Library.h> // Click here to get the library: http://librarymanager/All#SparkFun_PHT_MS8607
+
+#define PAGE_SIZE 256
+
+MS8607 barometricSensor;
+
+struct MS8607_record_codec encoder;
+uint8_t page[PAGE_SIZE];
+uint16_t pageLength = 0;
+uint16_t pageSamples = 0;
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Serial.println("Qwiic PHT Sensor MS8607 Example");
+
+  Wire.begin();
+
+  if (barometricSensor.begin() == false)
+  {
+    Serial.println("MS8607 sensor did not respond. Trying again...");
+    if (barometricSensor.begin() == false)
+    {
+      Serial.println("MS8607 sensor did not respond. Please check wiring.");
+      while (1)
+        ;
+    }
+  }
+
+  uint16_t coeff[7];
+  barometricSensor.get_prom_coefficients(coeff);
+
+  // A keyframe at the start of every page only
+  MS8607_record_encoder_init(&encoder, coeff, 0);
+}
+
+// Decode the page and print the number of records and the last one
+void checkPage(void)
+{
+  struct MS8607_record_codec decoder;
+  struct MS8607_record record;
+  uint16_t position = 0;
+  uint16_t records = 0;
+  int used;
+
+  MS8607_record_decoder_init(&decoder);
+  while (position < pageLength)
+  {
+    used = MS8607_record_decode(&decoder, page + position, pageLength - position, &record);
+    if (used <= 0)
+    {
+      Serial.println("Decode failed");
+      return;
+    }
+    position += used;
+    records++;
+  }
+
+  Serial.print("Decoded ");
+  Serial.print(records);
+  Serial.print(" records, last: t=");
+  Serial.print(record.timestamp);
+  Serial.print("ms T=");
+  Serial.print(record.temperature);
+  Serial.print(" P=");
+  Serial.print(record.pressure);
+  Serial.print(" RH=");
+  Serial.println(record.humidity);
+}
+
+void loop(void)
+{
+  struct MS8607_record record;
+
+  if (barometricSensor.read_temperature_pressure_humidity_fixed(&record.temperature, &record.pressure, &record.humidity) != MS8607_status_ok)
+  {
+    Serial.println("Read failed");
+    delay(100);
+    return;
+  }
+  record.timestamp = millis();
+  record.channels = MS8607_channel_all;
+
+  // Page full: "write" it and start the next one with a keyframe
+  if (pageLength + MS8607_RECORD_MAX_SIZE > PAGE_SIZE)
+  {
+    Serial.print("Page: ");
+    Serial.print(pageSamples);
+    Serial.print(" samples in ");
+    Serial.print(pageLength);
+    Serial.print(" bytes (CSV would need about ");
+    Serial.print(pageSamples * 30);
+    Serial.println(")");
+    checkPage();
+
+    pageLength = 0;
+    pageSamples = 0;
+    MS8607_record_keyframe(&encoder);
+  }
+
+  pageLength += MS8607_record_encode(&encoder, &record, page + pageLength);
+  pageSamples++;
+
+  delay(100);
+}
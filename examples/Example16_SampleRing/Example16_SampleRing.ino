@@ -0,0 +1,108 @@
+/*
+  Buffering MS8607 samples in a lock-free ring
+  By: SparkFun Electronics
+  License: MIT. See license file for more information but you can
+  basically do whatever you want with this code.
+
+  Feel like supporting open source hardware?
+  Buy a board from SparkFun!
+
+  set_sample_ring() makes the driver push every completed acquisition into
+  an MS8607_ring: a fixed size single producer / single consumer queue that
+  needs no heap and never disables interrupts. The code that drives the
+  acquisitions (startMeasurement() and poll()) is the producer, the code
+  that empties the ring is the consumer, and they can run in different
+  contexts: a timer task and loop(), two RTOS tasks, or an ISR on boards
+  whose I2C driver can be used from one. A burst never blocks either side:
+  when the ring is full the new sample is dropped and counted.
+
+  Here both sides run from loop(): the producer starts an acquisition every
+  100ms, the consumer drains the ring every second.
+
+  Hardware Connections:
+  Attach a Qwiic shield to your RedBoard or Uno.
+  Plug the Qwiic sensor into any port.
+  Serial.print it out at 115200 baud to serial monitor.
+*/
+
+#include <Wire.h>
+
+#include <SparkFun_PHT_MS8607_Arduino_Library.h> // Click here to get the library: http://librarymanager/All#SparkFun_PHT_MS8607
+
+MS8607 barometricSensor;
+
+// 16 samples, the capacity must be a power of 2
+MS8607_ring<16> ring;
+
+unsigned long lastStart = 0;
+unsigned long lastDrain = 0;
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Serial.println("Qwiic PHT Sensor MS8607 Example");
+
+  Wire.begin();
+
+  if (barometricSensor.begin() == false)
+  {
+    Serial.println("MS8607 sensor did not respond. Trying again...");
+    if (barometricSensor.begin() == false)
+    {
+      Serial.println("MS8607 sensor did not respond. Please check wiring.");
+      while (1)
+        ;
+    }
+  }
+
+  barometricSensor.set_sample_ring(&ring);
+}
+
+// Producer: keep the acquisitions going. A completed acquisition is pushed
+// into the ring by poll().
+void produce(void)
+{
+  barometricSensor.poll();
+
+  if (millis() - lastStart >= 100)
+  {
+    lastStart = millis();
+    barometricSensor.startMeasurement();
+  }
+}
+
+// Consumer: print everything buffered since the last call
+void consume(void)
+{
+  struct MS8607_sample_fixed sample;
+
+  Serial.print(ring.available());
+  Serial.print(" samples, ");
+  Serial.print(ring.dropped());
+  Serial.println(" dropped so far");
+
+  while (ring.pop(&sample))
+  {
+    Serial.print("  #");
+    Serial.print(sample.sequence);
+    Serial.print(" at ");
+    Serial.print(sample.timestamp);
+    Serial.print("ms: T=");
+    Serial.print(sample.temperature);
+    Serial.print(" P=");
+    Serial.print(sample.pressure);
+    Serial.print(" RH=");
+    Serial.println(sample.humidity);
+  }
+}
+
+void loop(void)
+{
+  produce();
+
+  if (millis() - lastDrain >= 1000)
+  {
+    lastDrain = millis();
+    consume();
+  }
+}
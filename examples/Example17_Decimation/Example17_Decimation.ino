@@ -0,0 +1,107 @@
+/*
+  Oversampling the MS8607 pressure with integer decimation filters
+  By: SparkFun Electronics
+  License: MIT. See license file for more information but you can
+  basically do whatever you want with this code.
+
+  Feel like supporting open source hardware?
+  Buy a board from SparkFun!
+
+  One conversion at OSR 8192 takes about 17ms. Here the pressure is read at
+  OSR 512 (about 1ms per conversion, and D2 only every 8th sample) and 32
+  samples are combined into one output by three integer filters:
+    - a boxcar, the plain mean of each block of 32 samples
+    - a 3rd order CIC, which rejects the noise above the output rate better
+    - a first order IIR with a time constant of 16 samples
+  The filters run on the integer pressure in Pa and keep 4 extra bits of
+  resolution (the outputs are in Pa / 16). There is no floating point on the
+  input path, only to print the results.
+
+  Hardware Connections:
+  Attach a Qwiic shield to your RedBoard or Uno.
+  Plug the Qwiic sensor into any port.
+  Serial.print it out at 115200 baud to serial monitor.
+*/
+
+#include <Wire.h>
+
+#include <SparkFun_PHT_MS8607_Arduino_Library.h> // Click here to get the library: http://librarymanager/All#SparkFun_PHT_MS8607
+
+#define RATIO 32
+
+MS8607 barometricSensor;
+
+struct MS8607_filter boxcar;
+struct MS8607_filter cic;
+struct MS8607_filter iir;
+
+unsigned long blockStart;
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Serial.println("Qwiic PHT Sensor MS8607 Example");
+
+  Wire.begin();
+
+  if (barometricSensor.begin() == false)
+  {
+    Serial.println("MS8607 sensor did not respond. Trying again...");
+    if (barometricSensor.begin() == false)
+    {
+      Serial.println("MS8607 sensor did not respond. Please check wiring.");
+      while (1)
+        ;
+    }
+  }
+
+  barometricSensor.set_pressure_resolution(MS8607_pressure_resolution_osr_512);
+  barometricSensor.set_temperature_refresh(8);
+
+  MS8607_filter_init(&boxcar, MS8607_filter_boxcar, RATIO, 0, 4);
+  MS8607_filter_init(&cic, MS8607_filter_cic, RATIO, 3, 4);
+  MS8607_filter_init(&iir, MS8607_filter_iir, RATIO, 4, 4);
+
+  blockStart = millis();
+}
+
+void printOutput(const char *name, int32_t output)
+{
+  Serial.print(name);
+  Serial.print(output / 1600.0, 4); // Pa / 16 to mbar
+  Serial.print("mbar ");
+}
+
+void loop(void)
+{
+  int32_t temperature, pressure;
+  int32_t boxcarOut, cicOut, iirOut;
+
+  if (barometricSensor.read_temperature_pressure_humidity_fixed(&temperature, &pressure, NULL, MS8607_channel_pressure) != MS8607_status_ok)
+  {
+    Serial.println("Read failed");
+    return;
+  }
+
+  // The three filters have the same ratio, so they produce their outputs
+  // together (the CIC skips its first 2 outputs)
+  bool boxcarReady = MS8607_filter_push(&boxcar, pressure, &boxcarOut);
+  bool cicReady = MS8607_filter_push(&cic, pressure, &cicOut);
+  bool iirReady = MS8607_filter_push(&iir, pressure, &iirOut);
+
+  if (boxcarReady)
+  {
+    Serial.print(millis() - blockStart);
+    Serial.print("ms for ");
+    Serial.print(RATIO);
+    Serial.print(" samples: ");
+    blockStart = millis();
+
+    printOutput("boxcar=", boxcarOut);
+    if (cicReady)
+      printOutput("CIC=", cicOut);
+    if (iirReady)
+      printOutput("IIR=", iirOut);
+    Serial.println();
+  }
+}
@@ -0,0 +1,94 @@
+/*
+  Altitude and climb rate from the MS8607 with a Kalman filter
+  By: SparkFun Electronics
+  License: MIT. See license file for more information but you can
+  basically do whatever you want with this code.
+
+  Feel like supporting open source hardware?
+  Buy a board from SparkFun!
+
+  altitudeChange() turns a single pressure reading into an altitude, so the
+  result is as noisy as the reading. MS8607_altitude_update() fuses every
+  pressure sample, with its timestamp, into an estimate of the altitude,
+  the vertical speed and the vertical acceleration. It takes the samples at
+  whatever rate they come, so the sensor can run flat out: here pressure
+  only, non-blocking, at OSR 4096 with D2 refreshed every 10 samples.
+
+  The altitude is relative to the pressure at power up. Pass 101325 (or the
+  local sea level pressure in Pa) to MS8607_altitude_init() for the altitude
+  above sea level.
+
+  Hardware Connections:
+  Attach a Qwiic shield to your RedBoard or Uno.
+  Plug the Qwiic sensor into any port.
+  Serial.print it out at 115200 baud to serial monitor.
+*/
+
+#include <Wire.h>
+
+#include <SparkFun_PHT_MS8607_Arduino_Library.h> // Click here to get the library: http://librarymanager/All#SparkFun_PHT_MS8607
+
+MS8607 barometricSensor;
+
+struct MS8607_altitude_estimator estimator;
+
+unsigned long lastPrint = 0;
+unsigned int samples = 0;
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Serial.println("Qwiic PHT Sensor MS8607 Example");
+
+  Wire.begin();
+
+  if (barometricSensor.begin() == false)
+  {
+    Serial.println("MS8607 sensor did not respond. Trying again...");
+    if (barometricSensor.begin() == false)
+    {
+      Serial.println("MS8607 sensor did not respond. Please check wiring.");
+      while (1)
+        ;
+    }
+  }
+
+  barometricSensor.set_pressure_resolution(MS8607_pressure_resolution_osr_4096);
+  barometricSensor.set_temperature_refresh(10);
+
+  // 0.2m of noise per sample, moderate jerk (walking, a slow drone)
+  MS8607_altitude_init(&estimator, 0.2, 1.0, 0);
+
+  barometricSensor.startMeasurement(MS8607_channel_pressure);
+}
+
+void loop(void)
+{
+  int32_t pressure;
+
+  if (barometricSensor.isReady())
+  {
+    if (barometricSensor.getResult_fixed(NULL, &pressure, NULL) == MS8607_status_ok)
+    {
+      MS8607_altitude_update(&estimator, pressure, millis());
+      samples++;
+    }
+    barometricSensor.startMeasurement(MS8607_channel_pressure);
+  }
+  else if (barometricSensor.getAcquisitionState() == MS8607_acquisition_error)
+    barometricSensor.startMeasurement(MS8607_channel_pressure);
+
+  if (millis() - lastPrint >= 500)
+  {
+    lastPrint = millis();
+
+    Serial.print("Altitude=");
+    Serial.print(estimator.altitude, 2);
+    Serial.print("m Climb rate=");
+    Serial.print(estimator.velocity, 2);
+    Serial.print("m/s (");
+    Serial.print(samples);
+    Serial.println(" samples)");
+    samples = 0;
+  }
+}
@@ -0,0 +1,159 @@
+/*
+  Fast altitude, sea level pressure and dew point without pow() or log10()
+  By: SparkFun Electronics
+  License: MIT. See license file for more information but you can
+  basically do whatever you want with this code.
+
+  Feel like supporting open source hardware?
+  Buy a board from SparkFun!
+
+  altitudeChange(), adjustToSeaLevel() and get_dew_point() call pow() and
+  log10() in double. This example computes the same values with the float
+  and the integer functions of SparkFun_PHT_MS8607_FastMath.h, and times 100
+  calls of each on your board with micros(), so you can pick the fastest one
+  for your processor. Define MS8607_FAST_MATH for the whole build to make
+  the driver functions themselves use the float functions.
+
+  Hardware Connections:
+  Attach a Qwiic shield to your RedBoard or Uno.
+  Plug the Qwiic sensor into any port.
+  Serial.print it out at 115200 baud to serial monitor.
+*/
+
+#include <Wire.h>
+
+#include <SparkFun_PHT_MS8607_Arduino_Library.h> // Click here to get the library: http://librarymanager/All#SparkFun_PHT_MS8607
+
+#define CALLS 100
+#define ALTITUDE 1600.0 // m, the altitude of Boulder, CO
+
+MS8607 barometricSensor;
+
+float baseline; // mbar, the pressure at power up
+int32_t baselineFixed;
+
+// Stop the compiler from optimising the loops away
+volatile float floatResult;
+volatile int32_t fixedResult;
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Serial.println("Qwiic PHT Sensor MS8607 Example");
+
+  Wire.begin();
+
+  if (barometricSensor.begin() == false)
+  {
+    Serial.println("MS8607 sensor did not respond. Trying again...");
+    if (barometricSensor.begin() == false)
+    {
+      Serial.println("MS8607 sensor did not respond. Please check wiring.");
+      while (1)
+        ;
+    }
+  }
+
+  barometricSensor.read_temperature_pressure_humidity_fixed(NULL, &baselineFixed, NULL, MS8607_channel_pressure);
+  baseline = baselineFixed / 100.0;
+}
+
+void printTime(const char *name, unsigned long start)
+{
+  Serial.print(name);
+  Serial.print((micros() - start) / (float)CALLS, 1);
+  Serial.println("us per call");
+}
+
+void loop(void)
+{
+  int32_t temperatureFixed, pressureFixed, humidityFixed;
+  float dewPoint;
+  unsigned long start;
+  int i;
+
+  if (barometricSensor.read_temperature_pressure_humidity_fixed(&temperatureFixed, &pressureFixed, &humidityFixed) != MS8607_status_ok)
+  {
+    Serial.println("Read failed");
+    return;
+  }
+  float temperature = temperatureFixed / 100.0;
+  float pressure = pressureFixed / 100.0;
+  float humidity = humidityFixed / 100.0;
+
+  Serial.print("Altitude change: pow()=");
+  Serial.print(barometricSensor.altitudeChange(pressure, baseline), 3);
+  Serial.print("m float=");
+  Serial.print(MS8607_altitude_change_fast(pressure, baseline), 3);
+  Serial.print("m fixed=");
+  Serial.print(MS8607_altitude_change_fixed(pressureFixed, baselineFixed) / 100.0, 2);
+  Serial.println("m");
+
+  Serial.print("Sea level pressure at 1600m: pow()=");
+  Serial.print(barometricSensor.adjustToSeaLevel(pressure, ALTITUDE), 2);
+  Serial.print("mbar float=");
+  Serial.print(MS8607_sea_level_pressure_fast(pressure, ALTITUDE), 2);
+  Serial.print("mbar fixed=");
+  Serial.print(MS8607_sea_level_pressure_fixed(pressureFixed, (int32_t)(ALTITUDE * 100)) / 100.0, 2);
+  Serial.println("mbar");
+
+  barometricSensor.get_dew_point(temperature, humidity, &dewPoint);
+  Serial.print("Dew point: log10()=");
+  Serial.print(dewPoint, 3);
+  Serial.print("C float=");
+  Serial.print(MS8607_dew_point_fast(temperature, humidity), 3);
+  Serial.print("C fixed=");
+  Serial.print(MS8607_dew_point_fixed(temperatureFixed, humidityFixed) / 100.0, 2);
+  Serial.println("C");
+
+  start = micros();
+  for (i = 0; i < CALLS; i++)
+    floatResult = barometricSensor.altitudeChange(pressure + i * 0.01, baseline);
+  printTime("  altitudeChange() : ", start);
+
+  start = micros();
+  for (i = 0; i < CALLS; i++)
+    floatResult = MS8607_altitude_change_fast(pressure + i * 0.01f, baseline);
+  printTime("  MS8607_altitude_change_fast() : ", start);
+
+  start = micros();
+  for (i = 0; i < CALLS; i++)
+    fixedResult = MS8607_altitude_change_fixed(pressureFixed + i, baselineFixed);
+  printTime("  MS8607_altitude_change_fixed() : ", start);
+
+  start = micros();
+  for (i = 0; i < CALLS; i++)
+    floatResult = barometricSensor.adjustToSeaLevel(pressure + i * 0.01, ALTITUDE);
+  printTime("  adjustToSeaLevel() : ", start);
+
+  start = micros();
+  for (i = 0; i < CALLS; i++)
+    floatResult = MS8607_sea_level_pressure_fast(pressure + i * 0.01f, ALTITUDE);
+  printTime("  MS8607_sea_level_pressure_fast() : ", start);
+
+  start = micros();
+  for (i = 0; i < CALLS; i++)
+    fixedResult = MS8607_sea_level_pressure_fixed(pressureFixed + i, (int32_t)(ALTITUDE * 100));
+  printTime("  MS8607_sea_level_pressure_fixed() : ", start);
+
+  start = micros();
+  for (i = 0; i < CALLS; i++)
+  {
+    barometricSensor.get_dew_point(temperature, humidity + i * 0.01, &dewPoint);
+    floatResult = dewPoint;
+  }
+  printTime("  get_dew_point() : ", start);
+
+  start = micros();
+  for (i = 0; i < CALLS; i++)
+    floatResult = MS8607_dew_point_fast(temperature, humidity + i * 0.01f);
+  printTime("  MS8607_dew_point_fast() : ", start);
+
+  start = micros();
+  for (i = 0; i < CALLS; i++)
+    fixedResult = MS8607_dew_point_fixed(temperatureFixed, humidityFixed + i);
+  printTime("  MS8607_dew_point_fixed() : ", start);
+
+  Serial.println();
+  delay(1000);
+}
@@ -0,0 +1,110 @@
+/*
+  Reading several MS8607 behind TCA9548A multiplexers
+  By: SparkFun Electronics
+  License: MIT. See license file for more information but you can
+  basically do whatever you want with this code.
+
+  Feel like supporting open source hardware?
+  Buy a board from SparkFun!
+
+  Every MS8607 answers at the same two addresses, so each one needs a
+  channel of a TCA9548A style mux (e.g. the Qwiic Mux). MS8607_Manager
+  keeps one driver per sensor, with its own PROM coefficients and settings,
+  routes the bus before each transaction and only writes a mux control
+  register when the next transaction is for a sensor on another channel.
+  read_all() overlaps the conversions: it starts one on every sensor, then
+  reads each sensor as soon as its conversion is done and starts the next
+  one, so 4 sensors take about as long as one. The bus goes back and forth
+  between the sensors, about 4 mux switches per sensor per read.
+  read_all_sequential() reads one sensor after the other in channel order:
+  one mux switch per sensor, but 4 times as long. The sketch alternates
+  between the two.
+
+  Here 4 sensors sit on channels 0 to 3 of a mux at 0x70 (the default
+  locations). Use set_location() for other wirings.
+
+  Hardware Connections:
+  Attach a Qwiic shield to your RedBoard or Uno.
+  Plug a Qwiic Mux into any port and the sensors into channels 0 to 3.
+  Serial.print it out at 115200 baud to serial monitor.
+*/
+
+#include <Wire.h>
+
+#include <SparkFun_PHT_MS8607_Manager.h> // Click here to get the library: http://librarymanager/All#SparkFun_PHT_MS8607
+
+#define SENSORS 4
+
+MS8607_Manager<SENSORS> sensors;
+
+struct MS8607_sample samples[SENSORS];
+
+bool sequential = false;
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Serial.println("Qwiic PHT Sensor MS8607 Example");
+
+  Wire.begin();
+
+  // Sensor i is on channel i of the mux at 0x70 by default, e.g.
+  // sensors.set_location(3, 0x71, 0); for the 4th sensor on another mux
+
+  uint8_t found = sensors.begin(Wire);
+  Serial.print(found);
+  Serial.print(" of ");
+  Serial.print(SENSORS);
+  Serial.println(" sensors found");
+  if (found == 0)
+  {
+    Serial.println("No MS8607 responded. Please check wiring.");
+    while (1)
+      ;
+  }
+
+  // Each sensor keeps its own settings, sensor(i) gives access to them
+  sensors.set_pressure_resolution(MS8607_pressure_resolution_osr_4096);
+  sensors.set_humidity_resolution(MS8607_humidity_resolution_12b);
+  sensors.sensor(0).set_pressure_resolution(MS8607_pressure_resolution_osr_8192);
+}
+
+void loop(void)
+{
+  uint32_t switches = sensors.get_switch_count();
+  unsigned long start = millis();
+
+  uint8_t read;
+  if (sequential)
+    read = sensors.read_all_sequential(samples);
+  else
+    read = sensors.read_all(samples);
+
+  Serial.print(read);
+  Serial.print(sequential ? " sensors read one by one in " : " sensors read overlapped in ");
+  Serial.print(millis() - start);
+  Serial.print("ms with ");
+  Serial.print(sensors.get_switch_count() - switches);
+  Serial.println(" mux switches");
+
+  for (uint8_t i = 0; i < SENSORS; i++)
+  {
+    Serial.print("  #");
+    Serial.print(i);
+    if (samples[i].channels == 0)
+    {
+      Serial.println(sensors.isPresent(i) ? ": read failed" : ": not found");
+      continue;
+    }
+    Serial.print(": T=");
+    Serial.print(samples[i].temperature, 2);
+    Serial.print("C P=");
+    Serial.print(samples[i].pressure, 2);
+    Serial.print("hPa RH=");
+    Serial.print(samples[i].humidity, 2);
+    Serial.println("%");
+  }
+
+  sequential = !sequential;
+  delay(1000);
+}
@@ -0,0 +1,114 @@
+/*
+  Overlapped non-blocking acquisitions on several MS8607
+  By: SparkFun Electronics
+  License: MIT. See license file for more information but you can
+  basically do whatever you want with this code.
+
+  Feel like supporting open source hardware?
+  Buy a board from SparkFun!
+
+  An acquisition is 3 conversions of up to 18ms each, and the bus is idle
+  while a sensor converts. MS8607_Manager interleaves the sensors:
+  start_all() starts a conversion on every sensor, then each poll_all()
+  reads the sensors whose conversion is done and starts their next one,
+  without waiting. loop() stays free for other work in between, and
+  getMicrosToNextStep() tells how long it can sleep.
+
+  The sensors are sampled back to back here, and the sketch counts how many
+  sweeps complete per second. With 8 sensors at 400kHz a sweep takes about
+  one acquisition (52ms at the default resolutions), instead of 8.
+
+  Hardware Connections:
+  Attach a Qwiic shield to your RedBoard or Uno.
+  Plug a Qwiic Mux into any port and the sensors into channels 0 to 7.
+  Serial.print it out at 115200 baud to serial monitor.
+*/
+
+#include <Wire.h>
+
+#include <SparkFun_PHT_MS8607_Manager.h> // Click here to get the library: http://librarymanager/All#SparkFun_PHT_MS8607
+
+#define SENSORS 8
+
+MS8607_Manager<SENSORS> sensors;
+
+struct MS8607_sample_fixed samples[SENSORS];
+
+unsigned long sweepStart = 0;
+unsigned long sweepTime = 0;
+unsigned long lastReport = 0;
+unsigned long sweeps = 0;
+unsigned long idleLoops = 0;
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Serial.println("Qwiic PHT Sensor MS8607 Example");
+
+  Wire.begin();
+  Wire.setClock(400000);
+
+  uint8_t found = sensors.begin(Wire);
+  Serial.print(found);
+  Serial.print(" of ");
+  Serial.print(SENSORS);
+  Serial.println(" sensors found");
+  if (found == 0)
+  {
+    Serial.println("No MS8607 responded. Please check wiring.");
+    while (1)
+      ;
+  }
+
+  sweepStart = millis();
+  sensors.start_all();
+}
+
+void loop(void)
+{
+  if (sensors.poll_all() > 0)
+  {
+    // Acquisitions in progress: do something else. A low power sketch could
+    // sleep for sensors.getMicrosToNextStep() here.
+    idleLoops++;
+    return;
+  }
+
+  sensors.getResults_fixed(samples);
+  sweepTime = millis() - sweepStart;
+  sweeps++;
+
+  if (millis() - lastReport >= 1000)
+  {
+    lastReport = millis();
+
+    Serial.print(sweeps);
+    Serial.print(" sweeps/s, last one ");
+    Serial.print(sweepTime);
+    Serial.print("ms, ");
+    Serial.print(idleLoops);
+    Serial.println(" idle loops");
+    sweeps = 0;
+    idleLoops = 0;
+
+    for (uint8_t i = 0; i < SENSORS; i++)
+    {
+      Serial.print("  #");
+      Serial.print(i);
+      if (samples[i].channels == 0)
+      {
+        Serial.println(": no result");
+        continue;
+      }
+      Serial.print(": T=");
+      Serial.print(samples[i].temperature);
+      Serial.print(" P=");
+      Serial.print(samples[i].pressure);
+      Serial.print(" RH=");
+      Serial.println(samples[i].humidity);
+    }
+  }
+
+  sweepStart = millis();
+  sensors.start_all();
+}
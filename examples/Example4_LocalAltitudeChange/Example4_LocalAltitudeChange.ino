@@ -20,6 +20,9 @@
   This example shows how to detect a local altitude change. At power up the sensor will
   take a series of readings, average them, and use that average pressure as a baseline.
   Moving up or down a flight of stairs will show a change in altitude.
+
+  The readings are averaged in integers (Pa) by a boxcar filter that keeps 4 extra
+  bits of resolution, see SparkFun_PHT_MS8607_Filter.h.
 */
 
 #include <Wire.h>
@@ -52,10 +55,24 @@ void setup(void)
   barometricSensor.set_pressure_resolution(MS8607_pressure_resolution_osr_8192);
 
   //Take 16 readings and average them
-  startingPressure = 0.0;
-  for (int x = 0; x < 16; x++)
-    startingPressure += barometricSensor.getPressure();
-  startingPressure /= (float)16;
+  struct MS8607_filter average;
+  MS8607_filter_init(&average, MS8607_filter_boxcar, 16, 0, 4); // 16 samples per output, in Pa / 16
+
+  int32_t pressure, temperature, averagePressure = 0;
+  int failures = 0;
+  bool done = false;
+  while (!done)
+  {
+    if (barometricSensor.read_temperature_pressure_humidity_fixed(&temperature, &pressure, NULL, MS8607_channel_pressure) == MS8607_status_ok)
+      done = MS8607_filter_push(&average, pressure, &averagePressure);
+    else if (++failures == 16) //Give up rather than wait forever
+    {
+      Serial.println("MS8607 sensor stopped responding. Please check wiring.");
+      while (1)
+        ;
+    }
+  }
+  startingPressure = averagePressure / 1600.0; // Pa / 16 to mbar
 
   Serial.print("Starting pressure=");
   Serial.print(startingPressure);
@@ -77,6 +77,20 @@ void setup(void)
   //  barometricSensor.set_pressure_resolution(MS8607_pressure_resolution_osr_2048); //5ms per reading, 0.028mbar resolution
   //  barometricSensor.set_pressure_resolution(MS8607_pressure_resolution_osr_4096); //9ms per reading, 0.021mbar resolution
   barometricSensor.set_pressure_resolution(MS8607_pressure_resolution_osr_8192); //17ms per reading, 0.016mbar resolution
+
+  //Each pressure reading normally needs a temperature conversion first.
+  //Temperature changes slowly, so you can reuse it for several pressure readings
+  //to almost double the pressure sample rate:
+  //  barometricSensor.set_temperature_refresh(10, 1000); //Convert temperature every 10 readings or every second
+
+  //The conversion times above are worst case values. Most parts finish sooner.
+  //Adaptive timing learns how long your sensor really takes:
+  //  barometricSensor.set_adaptive_timing(true);
+  //  Serial.println(barometricSensor.get_pressure_conversion_time(MS8607_pressure_resolution_osr_8192)); //Learned time in us
+
+  //On long or noisy cables, retry failed transfers and recover a stuck bus:
+  //  MS8607_retry_policy retry = {3, 200, 5000, 5}; //3 retries, 200us backoff (doubling), 5ms limit, recover after 5 failures
+  //  barometricSensor.set_retry_policy(retry);
 }
 
 void loop(void)
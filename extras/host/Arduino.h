@@ -0,0 +1,86 @@
+/*
+  Minimal Arduino core shim so the MS8607 library can be built and run on a
+  Linux host against the simulated device in MS8607_Simulator.h.
+
+  Time is virtual: delay() and delayMicroseconds() advance the clock instead of
+  sleeping, and every call to micros() or millis() advances it by one
+  microsecond so busy-wait loops always make progress.
+*/
+
+#ifndef MS8607_HOST_ARDUINO_H
+#define MS8607_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef ARDUINO
+#define ARDUINO 10810
+#endif
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define F(string_literal) (string_literal)
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+void noInterrupts(void);
+void interrupts(void);
+
+#define DEC 10
+#define HEX 16
+
+// Serial writes to stdout
+class HardwareSerial
+{
+public:
+  void begin(unsigned long baud) { (void)baud; }
+  operator bool() { return true; }
+  int available(void) { return 0; }
+  int read(void) { return -1; }
+  size_t write(uint8_t c);
+  size_t write(const uint8_t *buffer, size_t size);
+  size_t print(const char *s);
+  size_t print(char c);
+  size_t print(long n, int base = DEC);
+  size_t print(unsigned long n, int base = DEC);
+  size_t print(int n, int base = DEC) { return print((long)n, base); }
+  size_t print(unsigned int n, int base = DEC) { return print((unsigned long)n, base); }
+  size_t print(long long n, int base = DEC);
+  size_t print(unsigned long long n, int base = DEC);
+  size_t print(double n, int digits = 2);
+  size_t println(void);
+  template <typename T> size_t println(T value) { size_t n = print(value); return n + println(); }
+  template <typename T> size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+  void flush(void) {}
+};
+
+extern HardwareSerial Serial;
+
+// Host clock control and accounting
+uint64_t host_clock_us(void);
+void host_clock_advance_us(uint64_t us);
+uint64_t host_delay_us_total(void);
+void host_clock_reset_counters(void);
+
+#endif
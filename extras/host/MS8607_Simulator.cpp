@@ -0,0 +1,471 @@
+#include "MS8607_Simulator.h"
+
+// Typical conversion times (us). The driver waits for the datasheet maxima.
+static const uint32_t default_pressure_conversion_us[6] = {
+    480, 940, 1850, 3680, 7330, 14630};
+// Indexed like MS8607_humidity_resolution: 12b, 8b, 10b, 11b
+static const uint32_t default_humidity_conversion_us[4] = {
+    14000, 2000, 4000, 7000};
+static const uint16_t humidity_resolution_mask[4] = {
+    0xFFF0, 0xFF00, 0xFFC0, 0xFFE0};
+
+MS8607Simulator::MS8607Simulator()
+    : _serial(0x48540000A1B2C3D4ULL), _temperature(25.0f),
+      _pressure(1013.25f), _humidity(45.0f), _pNoise(0), _hNoise(0),
+      _seed(12345)
+{
+  _pressureDie.owner = this;
+  _humidityDie.owner = this;
+
+  // Coefficients from the datasheet example, with a valid CRC-4 in word 0
+  _prom[0] = 0x0B60;
+  _prom[1] = 46372;
+  _prom[2] = 43981;
+  _prom[3] = 29059;
+  _prom[4] = 27842;
+  _prom[5] = 31553;
+  _prom[6] = 28165;
+  _prom[7] = 0;
+  _prom[0] |= (uint16_t)crc4(_prom) << 12;
+
+  memcpy(_pConversionUs, default_pressure_conversion_us, sizeof(_pConversionUs));
+  memcpy(_hConversionUs, default_humidity_conversion_us, sizeof(_hConversionUs));
+
+  _pRead = P_IDLE;
+  _pPromAddress = 0;
+  _pConverting = false;
+  _pReadyAt = 0;
+  _pResult = 0;
+  _pResultValid = false;
+  _pCorrupted = false;
+  _pFailures = 0;
+
+  _hRead = H_IDLE;
+  _userRegister = 0x02;
+  _hReadyAt = 0;
+  _hFailures = 0;
+  _hCrcErrors = 0;
+
+  resetCounters();
+}
+
+void MS8607Simulator::attach(TwoWire &bus)
+{
+  bus.attach(0x76, &_pressureDie);
+  bus.attach(0x40, &_humidityDie);
+}
+
+void MS8607Simulator::detach(TwoWire &bus)
+{
+  bus.detach(0x76);
+  bus.detach(0x40);
+}
+
+void MS8607Simulator::setEnvironment(float temperature, float pressure,
+                                     float humidity)
+{
+  _temperature = temperature;
+  _pressure = pressure;
+  _humidity = humidity;
+}
+
+void MS8607Simulator::setNoise(uint32_t pressureCounts, uint32_t humidityCounts)
+{
+  _pNoise = pressureCounts;
+  _hNoise = humidityCounts;
+}
+
+void MS8607Simulator::setPressureConversionTime(uint8_t osr, uint32_t us)
+{
+  if (osr < 6)
+    _pConversionUs[osr] = us;
+}
+
+void MS8607Simulator::setHumidityConversionTime(uint8_t resolution, uint32_t us)
+{
+  if (resolution < 4)
+    _hConversionUs[resolution] = us;
+}
+
+void MS8607Simulator::resetCounters(void)
+{
+  _pConversions = 0;
+  _hConversions = 0;
+  _promReads = 0;
+  _earlyReads = 0;
+  _corruptedReads = 0;
+}
+
+// CRC-8, polynomial x^8 + x^5 + x^4 + 1, initial value 0
+uint8_t MS8607Simulator::crc8(const uint8_t *data, size_t length)
+{
+  uint8_t crc = 0;
+  for (size_t i = 0; i < length; i++)
+  {
+    crc ^= data[i];
+    for (uint8_t bit = 0; bit < 8; bit++)
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+  }
+  return crc;
+}
+
+// PROM CRC-4 as described in the datasheet (word 7 is treated as 0)
+uint8_t MS8607Simulator::crc4(const uint16_t *prom)
+{
+  uint16_t n_rem = 0;
+  for (uint8_t cnt = 0; cnt < 16; cnt++)
+  {
+    uint16_t word = (cnt >> 1) == 7 ? 0 : prom[cnt >> 1];
+    if ((cnt >> 1) == 0)
+      word &= 0x0FFF;
+    n_rem ^= (cnt & 1) ? (word & 0x00FF) : (word >> 8);
+    for (uint8_t n_bit = 8; n_bit > 0; n_bit--)
+      n_rem = (n_rem & 0x8000) ? (uint16_t)((n_rem << 1) ^ 0x3000)
+                               : (uint16_t)(n_rem << 1);
+  }
+  return (n_rem >> 12) & 0xF;
+}
+
+int32_t MS8607Simulator::noise(uint32_t counts)
+{
+  if (counts == 0)
+    return 0;
+  _seed = _seed * 1103515245UL + 12345UL;
+  return (int32_t)((_seed >> 8) % (counts + 1)) - (int32_t)(counts / 2);
+}
+
+uint32_t MS8607Simulator::rawTemperature(void)
+{
+  // Solve TEMP - T2 = target for dT, refining for the second order term
+  int64_t target = (int64_t)lround(_temperature * 100.0f);
+  int64_t TEMP = target;
+  int64_t dT = 0;
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    dT = ((TEMP - 2000) << 23) / (int64_t)_prom[6];
+    int64_t T2 = (TEMP < 2000) ? (3 * dT * dT) >> 33 : (5 * dT * dT) >> 38;
+    TEMP = target + T2;
+  }
+  int64_t d2 = ((int64_t)_prom[5] << 8) + dT + noise(_pNoise);
+  if (d2 < 1)
+    d2 = 1;
+  if (d2 > 0xFFFFFF)
+    d2 = 0xFFFFFF;
+  return (uint32_t)d2;
+}
+
+uint32_t MS8607Simulator::rawPressure(void)
+{
+  // Run the forward compensation on the temperature word the die would
+  // produce, then solve P = ((D1 * SENS >> 21) - OFF) >> 15 for D1
+  int64_t dT = (int64_t)rawTemperature() - ((int64_t)_prom[5] << 8);
+  int64_t TEMP = 2000 + ((dT * (int64_t)_prom[6]) >> 23);
+  int64_t OFF2 = 0, SENS2 = 0;
+
+  if (TEMP < 2000)
+  {
+    OFF2 = 61 * (TEMP - 2000) * (TEMP - 2000) / 16;
+    SENS2 = 29 * (TEMP - 2000) * (TEMP - 2000) / 16;
+    if (TEMP < -1500)
+    {
+      OFF2 += 17 * (TEMP + 1500) * (TEMP + 1500);
+      SENS2 += 9 * (TEMP + 1500) * (TEMP + 1500);
+    }
+  }
+
+  int64_t OFF = ((int64_t)_prom[2] << 17) + (((int64_t)_prom[4] * dT) >> 6) - OFF2;
+  int64_t SENS = ((int64_t)_prom[1] << 16) + (((int64_t)_prom[3] * dT) >> 7) - SENS2;
+  int64_t P = (int64_t)llround(_pressure * 100.0f);
+  int64_t d1 = ((((P << 15) + OFF) << 21) + SENS - 1) / SENS + noise(_pNoise);
+
+  if (d1 < 1)
+    d1 = 1;
+  if (d1 > 0xFFFFFF)
+    d1 = 0xFFFFFF;
+  return (uint32_t)d1;
+}
+
+uint16_t MS8607Simulator::rawHumidity(void)
+{
+  uint8_t resolution = ((_userRegister & 0x80) ? 2 : 0) | (_userRegister & 0x01);
+  int32_t s = (int32_t)lroundf((_humidity + 6.0f) * 65536.0f / 125.0f) +
+              noise(_hNoise);
+  if (s < 0)
+    s = 0;
+  if (s > 0xFFFF)
+    s = 0xFFFF;
+  // The 2 status bits read back as 0b10 for a humidity measurement
+  return ((uint16_t)s & humidity_resolution_mask[resolution]) | 0x02;
+}
+
+bool MS8607Simulator::PressureDie::onWrite(const uint8_t *data, size_t length)
+{
+  return owner->pressureWrite(data, length);
+}
+
+size_t MS8607Simulator::PressureDie::onRead(uint8_t *data, size_t length)
+{
+  return owner->pressureRead(data, length);
+}
+
+bool MS8607Simulator::HumidityDie::onWrite(const uint8_t *data, size_t length)
+{
+  return owner->humidityWrite(data, length);
+}
+
+size_t MS8607Simulator::HumidityDie::onRead(uint8_t *data, size_t length)
+{
+  return owner->humidityRead(data, length);
+}
+
+bool MS8607Simulator::pressureWrite(const uint8_t *data, size_t length)
+{
+  if (_pFailures)
+  {
+    _pFailures--;
+    return false;
+  }
+  if (length == 0) // Address probe
+    return true;
+
+  uint8_t cmd = data[0];
+  _pRead = P_IDLE;
+
+  if (cmd == 0x1E) // Reset
+  {
+    _pConverting = false;
+    _pResultValid = false;
+  }
+  else if ((cmd & 0xF0) == 0xA0) // PROM read
+  {
+    _pRead = P_PROM;
+    _pPromAddress = (cmd >> 1) & 0x07;
+  }
+  else if (((cmd & 0xF0) == 0x40) || ((cmd & 0xF0) == 0x50)) // Conversion
+  {
+    uint8_t osr = (cmd & 0x0F) >> 1;
+    if (osr > 5)
+      return false;
+    _pConverting = true;
+    _pResultValid = false;
+    _pCorrupted = false;
+    _pReadyAt = host_clock_us() + _pConversionUs[osr];
+    _pResult = ((cmd & 0xF0) == 0x40) ? rawPressure() : rawTemperature();
+    _pConversions++;
+  }
+  else if (cmd == 0x00) // ADC read
+  {
+    _pRead = P_ADC;
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+size_t MS8607Simulator::pressureRead(uint8_t *data, size_t length)
+{
+  if (_pFailures)
+  {
+    _pFailures--;
+    return 0;
+  }
+
+  if ((_pRead == P_PROM) && (length >= 2))
+  {
+    data[0] = _prom[_pPromAddress] >> 8;
+    data[1] = _prom[_pPromAddress] & 0xFF;
+    _promReads++;
+    _pRead = P_IDLE;
+    return 2;
+  }
+
+  if ((_pRead == P_ADC) && (length >= 3))
+  {
+    uint32_t value = 0;
+
+    if (_pConverting && (host_clock_us() >= _pReadyAt))
+    {
+      _pConverting = false;
+      _pResultValid = true;
+    }
+    if (_pResultValid)
+    {
+      value = _pResult;
+      _pResultValid = false; // A repeated read returns 0
+      if (_pCorrupted)
+      {
+        // The datasheet leaves the result undefined; flip some middle bits so
+        // it stays plausible but wrong
+        value ^= 0x0F0F0;
+        _corruptedReads++;
+      }
+    }
+    else if (_pConverting)
+    {
+      // The conversion keeps running but its result is corrupted; this read
+      // returns 0
+      _pCorrupted = true;
+      _earlyReads++;
+    }
+    data[0] = (value >> 16) & 0xFF;
+    data[1] = (value >> 8) & 0xFF;
+    data[2] = value & 0xFF;
+    _pRead = P_IDLE;
+    return 3;
+  }
+
+  // Reads without a preceding command clock out 0xFF
+  for (size_t i = 0; i < length; i++)
+    data[i] = 0xFF;
+  return length;
+}
+
+bool MS8607Simulator::humidityWrite(const uint8_t *data, size_t length)
+{
+  if (_hFailures)
+  {
+    _hFailures--;
+    return false;
+  }
+  if (length == 0) // Address probe
+    return true;
+
+  uint8_t cmd = data[0];
+  uint8_t resolution = ((_userRegister & 0x80) ? 2 : 0) | (_userRegister & 0x01);
+
+  // The die NACKs commands while a no-hold conversion is in progress
+  if ((_hRead == H_MEASURE_NO_HOLD) && (host_clock_us() < _hReadyAt))
+    return false;
+
+  _hRead = H_IDLE;
+
+  switch (cmd)
+  {
+  case 0xFE: // Reset
+    _userRegister = 0x02;
+    break;
+  case 0xE7: // Read user register
+    _hRead = H_USER_REGISTER;
+    break;
+  case 0xE6: // Write user register
+    if (length < 2)
+      return false;
+    // Battery status is read only
+    _userRegister = (data[1] & ~0x40) | (_userRegister & 0x40);
+    break;
+  case 0xE5: // Measure RH, hold master
+  case 0xF5: // Measure RH, no hold master
+    _hRead = (cmd == 0xE5) ? H_MEASURE_HOLD : H_MEASURE_NO_HOLD;
+    _hReadyAt = host_clock_us() + _hConversionUs[resolution];
+    _hConversions++;
+    break;
+  case 0xFA:
+    if ((length < 2) || (data[1] != 0x0F))
+      return false;
+    _hRead = H_SERIAL_FIRST;
+    break;
+  case 0xFC:
+    if ((length < 2) || (data[1] != 0xC9))
+      return false;
+    _hRead = H_SERIAL_LAST;
+    break;
+  default:
+    return false;
+  }
+  return true;
+}
+
+size_t MS8607Simulator::humidityRead(uint8_t *data, size_t length)
+{
+  if (_hFailures)
+  {
+    _hFailures--;
+    return 0;
+  }
+
+  switch (_hRead)
+  {
+  case H_USER_REGISTER:
+    if (length < 1)
+      return 0;
+    data[0] = _userRegister;
+    _hRead = H_IDLE;
+    return 1;
+
+  case H_MEASURE_HOLD:
+  case H_MEASURE_NO_HOLD:
+  {
+    if (host_clock_us() < _hReadyAt)
+    {
+      if (_hRead == H_MEASURE_NO_HOLD)
+      {
+        _earlyReads++;
+        return 0; // NACK until the conversion completes
+      }
+      // Hold master: the die stretches SCL until the conversion completes
+      host_clock_advance_us(_hReadyAt - host_clock_us());
+    }
+    if (length < 2)
+      return 0;
+    uint16_t s = rawHumidity();
+    uint8_t word[2] = {(uint8_t)(s >> 8), (uint8_t)(s & 0xFF)};
+    uint8_t crc = crc8(word, 2);
+    if (_hCrcErrors)
+    {
+      _hCrcErrors--;
+      crc ^= 0x5A;
+    }
+    data[0] = word[0];
+    data[1] = word[1];
+    if (length > 2)
+      data[2] = crc;
+    _hRead = H_IDLE;
+    return length > 3 ? 3 : length;
+  }
+
+  case H_SERIAL_FIRST:
+  {
+    // SNB_3, CRC, SNB_2, CRC, SNB_1, CRC, SNB_0, CRC
+    uint8_t out[8];
+    for (uint8_t i = 0; i < 4; i++)
+    {
+      out[i * 2] = (uint8_t)(_serial >> (56 - i * 8));
+      out[i * 2 + 1] = crc8(&out[i * 2], 1);
+    }
+    size_t n = length < 8 ? length : 8;
+    memcpy(data, out, n);
+    _hRead = H_IDLE;
+    return n;
+  }
+
+  case H_SERIAL_LAST:
+  {
+    // SNC_1, SNC_0, CRC, SNA_1, SNA_0, CRC
+    uint8_t out[6];
+    out[0] = (uint8_t)(_serial >> 24);
+    out[1] = (uint8_t)(_serial >> 16);
+    out[2] = crc8(&out[0], 2);
+    out[3] = (uint8_t)(_serial >> 8);
+    out[4] = (uint8_t)_serial;
+    out[5] = crc8(&out[3], 2);
+    size_t n = length < 6 ? length : 6;
+    memcpy(data, out, n);
+    _hRead = H_IDLE;
+    return n;
+  }
+
+  default:
+    for (size_t i = 0; i < length; i++)
+      data[i] = 0xFF;
+    return length;
+  }
+}
+
+void MS8607Simulator::setPromWord(uint8_t index, uint16_t value)
+{
+  _prom[index] = value;
+  _prom[0] &= 0x0FFF;
+  _prom[0] |= (uint16_t)crc4(_prom) << 12;
+}
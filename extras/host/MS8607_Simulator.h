@@ -0,0 +1,154 @@
+/*
+  Host-side model of the TE MS8607 for functional and performance testing of
+  the library without hardware.
+
+  The model answers both dies on a host TwoWire bus:
+    - 0x76 pressure die: reset, PROM reads (with a valid CRC-4), D1/D2
+      conversions at every OSR with realistic conversion times, and an ADC read
+      that returns 0 when the conversion has not completed.
+    - 0x40 humidity die: reset, user register read/write (resolution, heater,
+      battery and reserved bits), hold and no-hold RH measurements (no-hold
+      reads are NACKed until the conversion completes) and the two-part serial
+      number read, all with CRC-8.
+
+  Raw ADC words are derived from the environment set with setEnvironment() by
+  inverting the datasheet compensation, so the driver should report the same
+  values back (to within the ADC quantisation and optional noise).
+*/
+
+#ifndef MS8607_SIMULATOR_H
+#define MS8607_SIMULATOR_H
+
+#include "Arduino.h"
+#include "Wire.h"
+
+class MS8607Simulator
+{
+public:
+  MS8607Simulator();
+
+  // Attach both dies to the bus
+  void attach(TwoWire &bus);
+  void detach(TwoWire &bus);
+
+  // The two dies, to attach them elsewhere (e.g. behind a TCA9548ASimulator)
+  TwoWireTarget *pressureDie(void) { return &_pressureDie; }
+  TwoWireTarget *humidityDie(void) { return &_humidityDie; }
+
+  // Environment seen by the sensor
+  void setEnvironment(float temperature, float pressure, float humidity);
+
+  // Peak-to-peak noise added to each raw ADC word (in counts)
+  void setNoise(uint32_t pressureCounts, uint32_t humidityCounts);
+
+  // Actual conversion time of the model, indexed like the driver enums
+  void setPressureConversionTime(uint8_t osr, uint32_t us);
+  void setHumidityConversionTime(uint8_t resolution, uint32_t us);
+
+  // Make the next n transactions on a die fail (NACK)
+  void failNextPressureTransfers(uint8_t n) { _pFailures = n; }
+  void failNextHumidityTransfers(uint8_t n) { _hFailures = n; }
+
+  // Corrupt the CRC of the next n humidity words
+  void corruptNextHumidityCrc(uint8_t n) { _hCrcErrors = n; }
+
+  const uint16_t *prom(void) const { return _prom; }
+  // Replace a PROM coefficient (1..6) and recompute the CRC-4, e.g. to
+  // model a different device behind the same bus
+  void setPromWord(uint8_t index, uint16_t value);
+  uint64_t serialNumber(void) const { return _serial; }
+  void setSerialNumber(uint64_t serial) { _serial = serial; }
+  uint8_t userRegister(void) const { return _userRegister; }
+
+  // Counters
+  uint32_t pressureConversions(void) const { return _pConversions; }
+  uint32_t humidityConversions(void) const { return _hConversions; }
+  uint32_t promReads(void) const { return _promReads; }
+  uint32_t earlyAdcReads(void) const { return _earlyReads; }
+  // ADC results returned from a conversion disturbed by an early read
+  uint32_t corruptedAdcReads(void) const { return _corruptedReads; }
+  void resetCounters(void);
+
+  static uint8_t crc8(const uint8_t *data, size_t length);
+  static uint8_t crc4(const uint16_t *prom);
+
+private:
+  class PressureDie : public TwoWireTarget
+  {
+  public:
+    MS8607Simulator *owner;
+    bool onWrite(const uint8_t *data, size_t length);
+    size_t onRead(uint8_t *data, size_t length);
+  };
+
+  class HumidityDie : public TwoWireTarget
+  {
+  public:
+    MS8607Simulator *owner;
+    bool onWrite(const uint8_t *data, size_t length);
+    size_t onRead(uint8_t *data, size_t length);
+  };
+
+  bool pressureWrite(const uint8_t *data, size_t length);
+  size_t pressureRead(uint8_t *data, size_t length);
+  bool humidityWrite(const uint8_t *data, size_t length);
+  size_t humidityRead(uint8_t *data, size_t length);
+
+  uint32_t rawTemperature(void);
+  uint32_t rawPressure(void);
+  uint16_t rawHumidity(void);
+  int32_t noise(uint32_t counts);
+
+  PressureDie _pressureDie;
+  HumidityDie _humidityDie;
+
+  uint16_t _prom[8];
+  uint64_t _serial;
+  float _temperature;
+  float _pressure;
+  float _humidity;
+  uint32_t _pNoise;
+  uint32_t _hNoise;
+  uint32_t _seed;
+
+  uint32_t _pConversionUs[6];
+  uint32_t _hConversionUs[4];
+
+  // Pressure die state
+  enum
+  {
+    P_IDLE,
+    P_PROM,
+    P_ADC
+  } _pRead;
+  uint8_t _pPromAddress;
+  bool _pConverting;
+  uint64_t _pReadyAt;
+  uint32_t _pResult;
+  bool _pResultValid;
+  bool _pCorrupted;
+  uint8_t _pFailures;
+
+  // Humidity die state
+  enum
+  {
+    H_IDLE,
+    H_USER_REGISTER,
+    H_MEASURE_HOLD,
+    H_MEASURE_NO_HOLD,
+    H_SERIAL_FIRST,
+    H_SERIAL_LAST
+  } _hRead;
+  uint8_t _userRegister;
+  uint64_t _hReadyAt;
+  uint8_t _hFailures;
+  uint8_t _hCrcErrors;
+
+  uint32_t _pConversions;
+  uint32_t _hConversions;
+  uint32_t _promReads;
+  uint32_t _earlyReads;
+  uint32_t _corruptedReads;
+};
+
+#endif
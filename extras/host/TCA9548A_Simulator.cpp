@@ -0,0 +1,107 @@
+#include "TCA9548A_Simulator.h"
+
+TCA9548ASimulator::TCA9548ASimulator() : _deviceCount(0)
+{
+  for (uint8_t i = 0; i < 8; i++)
+  {
+    _mux[i].control = 0;
+    _mux[i].owner = this;
+    _muxAttached[i] = false;
+  }
+  for (uint8_t i = 0; i < 128; i++)
+  {
+    _routes[i].address = i;
+    _routes[i].owner = this;
+  }
+  resetCounters();
+}
+
+void TCA9548ASimulator::attachMux(TwoWire &bus, uint8_t muxAddress)
+{
+  uint8_t index = (muxAddress - 0x70) & 0x07;
+  _mux[index].control = 0; // Power on state: every channel off
+  _muxAttached[index] = true;
+  bus.attach(muxAddress, &_mux[index]);
+}
+
+bool TCA9548ASimulator::attachDevice(TwoWire &bus, uint8_t muxAddress,
+                                     uint8_t channel, uint8_t address,
+                                     TwoWireTarget *target)
+{
+  if (_deviceCount == TCA9548A_SIM_MAX_DEVICES)
+    return false;
+
+  Device &device = _devices[_deviceCount++];
+  device.mux = (muxAddress == TCA9548A_SIM_DIRECT) ? TCA9548A_SIM_DIRECT
+                                                   : ((muxAddress - 0x70) & 0x07);
+  device.channel = channel & 0x07;
+  device.address = address & 0x7F;
+  device.target = target;
+  bus.attach(device.address, &_routes[device.address]);
+  return true;
+}
+
+uint8_t TCA9548ASimulator::controlRegister(uint8_t muxAddress) const
+{
+  return _mux[(muxAddress - 0x70) & 0x07].control;
+}
+
+void TCA9548ASimulator::resetCounters(void)
+{
+  _controlWrites = 0;
+  _conflicts = 0;
+}
+
+TwoWireTarget *TCA9548ASimulator::reachable(uint8_t address)
+{
+  TwoWireTarget *found = NULL;
+  uint8_t count = 0;
+
+  for (uint8_t i = 0; i < _deviceCount; i++)
+  {
+    const Device &device = _devices[i];
+    if (device.address != address)
+      continue;
+    if ((device.mux != TCA9548A_SIM_DIRECT) &&
+        (!_muxAttached[device.mux] || !(_mux[device.mux].control & (1 << device.channel))))
+      continue;
+    found = device.target;
+    count++;
+  }
+  if (count > 1)
+  {
+    _conflicts++;
+    return NULL;
+  }
+  return found;
+}
+
+bool TCA9548ASimulator::Mux::onWrite(const uint8_t *data, size_t length)
+{
+  // A write of only the address is a probe. The last byte written wins.
+  if (length > 0)
+  {
+    control = data[length - 1];
+    owner->_controlWrites++;
+  }
+  return true;
+}
+
+size_t TCA9548ASimulator::Mux::onRead(uint8_t *data, size_t length)
+{
+  for (size_t i = 0; i < length; i++)
+    data[i] = control;
+  return length;
+}
+
+bool TCA9548ASimulator::Route::onWrite(const uint8_t *data, size_t length)
+{
+  TwoWireTarget *target = owner->reachable(address);
+  return (target != NULL) && target->onWrite(data, length);
+}
+
+size_t TCA9548ASimulator::Route::onRead(uint8_t *data, size_t length)
+{
+  TwoWireTarget *target = owner->reachable(address);
+  return (target != NULL) ? target->onRead(data, length) : 0;
+}
@@ -0,0 +1,83 @@
+/*
+  Host-side model of TCA9548A I2C multiplexers, for testing several MS8607
+  on one host TwoWire bus.
+
+  Each mux answers at its own address (0x70 to 0x77) with a one byte control
+  register, one enable bit per downstream channel. Devices are attached to a
+  channel of a mux, or to the bus itself, with attachDevice(). A transaction
+  to a device address goes to the single device that is reachable through
+  the enabled channels:
+    - none : NACK
+    - more than one (e.g. the same MS8607 address on two enabled channels) :
+      NACK, counted by conflicts()
+*/
+
+#ifndef TCA9548A_SIMULATOR_H
+#define TCA9548A_SIMULATOR_H
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#define TCA9548A_SIM_DIRECT 0xFF // attachDevice() mux for the bus itself
+#define TCA9548A_SIM_MAX_DEVICES 128
+
+class TCA9548ASimulator
+{
+public:
+  TCA9548ASimulator();
+
+  // Put a mux on the bus
+  void attachMux(TwoWire &bus, uint8_t muxAddress);
+
+  // Put a device behind a channel of a mux (attached with attachMux()), or on
+  // the bus itself with TCA9548A_SIM_DIRECT
+  bool attachDevice(TwoWire &bus, uint8_t muxAddress, uint8_t channel,
+                    uint8_t address, TwoWireTarget *target);
+
+  uint8_t controlRegister(uint8_t muxAddress) const;
+
+  // Counters
+  uint32_t controlWrites(void) const { return _controlWrites; }
+  uint32_t conflicts(void) const { return _conflicts; }
+  void resetCounters(void);
+
+private:
+  class Mux : public TwoWireTarget
+  {
+  public:
+    uint8_t control;
+    TCA9548ASimulator *owner;
+    bool onWrite(const uint8_t *data, size_t length);
+    size_t onRead(uint8_t *data, size_t length);
+  };
+
+  // Stands for every device at one address on the bus
+  class Route : public TwoWireTarget
+  {
+  public:
+    uint8_t address;
+    TCA9548ASimulator *owner;
+    bool onWrite(const uint8_t *data, size_t length);
+    size_t onRead(uint8_t *data, size_t length);
+  };
+
+  struct Device
+  {
+    uint8_t mux; // Index in _mux, or TCA9548A_SIM_DIRECT
+    uint8_t channel;
+    uint8_t address;
+    TwoWireTarget *target;
+  };
+
+  TwoWireTarget *reachable(uint8_t address);
+
+  Mux _mux[8];
+  bool _muxAttached[8];
+  Route _routes[128];
+  Device _devices[TCA9548A_SIM_MAX_DEVICES];
+  uint8_t _deviceCount;
+  uint32_t _controlWrites;
+  uint32_t _conflicts;
+};
+
+#endif
@@ -0,0 +1,77 @@
+/*
+  Minimal TwoWire shim for host builds. Targets are attached with
+  Wire.attach() and see whole transactions: the bytes written between
+  beginTransmission() and endTransmission(), and each requestFrom().
+
+  The bus keeps its own clock model (start, address, data and ack bits at the
+  configured SCL rate) and advances the host clock accordingly.
+*/
+
+#ifndef MS8607_HOST_WIRE_H
+#define MS8607_HOST_WIRE_H
+
+#include "Arduino.h"
+
+class TwoWireTarget
+{
+public:
+  virtual ~TwoWireTarget() {}
+
+  // Return false to NACK the address or the data
+  virtual bool onWrite(const uint8_t *data, size_t length) = 0;
+
+  // Return the number of bytes supplied, 0 to NACK the address
+  virtual size_t onRead(uint8_t *data, size_t length) = 0;
+};
+
+struct TwoWireCounters
+{
+  uint32_t transactions; // Address phases (writes and reads)
+  uint32_t bytes;        // Bytes on the wire, including address bytes
+  uint32_t nacks;        // Address or data NACKs
+  uint64_t bus_us;       // Time the bus spent clocking
+};
+
+class TwoWire
+{
+public:
+  TwoWire();
+
+  void begin(void);
+  void end(void);
+  void setClock(uint32_t clock);
+
+  void beginTransmission(uint8_t address);
+  uint8_t endTransmission(bool sendStop = true);
+  size_t write(uint8_t data);
+  size_t write(const uint8_t *data, size_t length);
+
+  uint8_t requestFrom(uint8_t address, uint8_t quantity, bool sendStop = true);
+  int available(void);
+  int read(void);
+  int peek(void);
+
+  // Host extensions
+  void attach(uint8_t address, TwoWireTarget *target);
+  void detach(uint8_t address);
+  const TwoWireCounters &counters(void) const { return _counters; }
+  void resetCounters(void);
+
+private:
+  void account(size_t bytes);
+
+  TwoWireTarget *_targets[128];
+  uint32_t _clock;
+  uint8_t _txAddress;
+  uint8_t _txBuffer[32];
+  size_t _txLength;
+  bool _txOverflow;
+  uint8_t _rxBuffer[32];
+  size_t _rxLength;
+  size_t _rxIndex;
+  TwoWireCounters _counters;
+};
+
+extern TwoWire Wire;
+
+#endif
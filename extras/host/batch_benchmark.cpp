@@ -0,0 +1,93 @@
+/*
+  Throughput of the batch compensation, MS8607_compensate_batch(), on the host.
+
+  Compensates a buffer of raw samples spread over the whole operating range
+  (-40C to 85C, 10 to 2000mbar) several times and prints the samples per
+  second, then checks every result against the scalar functions.
+
+  usage: batch_benchmark [--samples N] [--runs N]
+
+  The batch kernel does not need the Arduino shim:
+
+    g++ -std=gnu++11 -O3 -march=native -Isrc extras/host/batch_benchmark.cpp \
+      src/SparkFun_PHT_MS8607_Compensation.cpp \
+      src/SparkFun_PHT_MS8607_CompensationBatch.cpp -o batch_benchmark
+*/
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "SparkFun_PHT_MS8607_Compensation.h"
+
+// C1 to C6 of the simulated device, see MS8607_Simulator.cpp. Word 0 (CRC and
+// factory data) is not used by the compensation.
+static const uint16_t prom[7] = {0, 46372, 43981, 29059, 27842, 31553, 28165};
+
+static uint32_t lcg = 12345;
+
+static uint32_t next_random(void)
+{
+  lcg = lcg * 1664525 + 1013904223;
+  return lcg >> 8; // 24 bits
+}
+
+int main(int argc, char **argv)
+{
+  size_t samples = 1 << 20;
+  unsigned runs = 20;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if ((strcmp(argv[i], "--samples") == 0) && (i + 1 < argc))
+      samples = strtoul(argv[++i], NULL, 10);
+    else if ((strcmp(argv[i], "--runs") == 0) && (i + 1 < argc))
+      runs = strtoul(argv[++i], NULL, 10);
+    else
+    {
+      fprintf(stderr, "usage: %s [--samples N] [--runs N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (samples == 0)
+    samples = 1;
+  if (runs == 0)
+    runs = 1;
+
+  std::vector<uint32_t> d1(samples), d2(samples);
+  std::vector<uint16_t> rh(samples);
+  std::vector<int32_t> t(samples), p(samples), h(samples);
+
+  // D2 from about -45C to 90C, D1 and RH over their full range
+  for (size_t i = 0; i < samples; i++)
+  {
+    d2[i] = ((uint32_t)prom[5] << 8) - 3400000 + next_random() % 6600000;
+    d1[i] = 1 + next_random() % 0xFFFFFF;
+    rh[i] = next_random();
+  }
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (unsigned r = 0; r < runs; r++)
+    MS8607_compensate_batch(prom, &d1[0], &d2[0], &rh[0], &t[0], &p[0], &h[0], samples);
+  double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  printf("%zu samples x %u runs: %.1f Msamples/s\n", samples, runs,
+         samples * (double)runs / seconds / 1e6);
+
+  size_t errors = 0;
+  for (size_t i = 0; i < samples; i++)
+  {
+    struct MS8607_temperature_terms terms;
+    MS8607_compensate_temperature(prom, d2[i], &terms);
+    if ((t[i] != terms.temperature) ||
+        (p[i] != MS8607_compensate_pressure(&terms, d1[i])) ||
+        (h[i] != MS8607_compensate_humidity(rh[i])))
+      errors++;
+  }
+  printf("%zu mismatches with the scalar compensation\n", errors);
+
+  return errors ? 1 : 0;
+}
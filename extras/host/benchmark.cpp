@@ -0,0 +1,173 @@
+/*
+  Acquisition benchmark for the MS8607 library on the host simulator.
+
+  Runs read_temperature_pressure_humidity() against the simulated device for
+  every pressure OSR x humidity resolution x humidity I2C master mode and
+  reports, per sample:
+    - wall time (virtual, including bus time)
+    - I2C transactions (address phases)
+    - bytes on the wire (including address bytes)
+    - time blocked in delay() / delayMicroseconds()
+
+  usage: benchmark [--json] [--samples N] [--clock Hz] [--pipelined]
+                   [--adaptive]
+
+  The output is CSV unless --json is given. Both are stable, so results can be
+  diffed between commits to catch latency regressions.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "MS8607_Simulator.h"
+#include "SparkFun_PHT_MS8607_Arduino_Library.h"
+
+static const char *const osr_names[] = {"256", "512", "1024", "2048", "4096", "8192"};
+static const char *const rh_names[] = {"12b", "8b", "10b", "11b"};
+static const char *const master_mode_names[] = {"hold", "no_hold"};
+
+struct result
+{
+  uint8_t osr;
+  uint8_t rh;
+  uint8_t master_mode;
+  uint32_t samples;
+  uint32_t errors;
+  double wall_us;
+  double transactions;
+  double bytes;
+  double delay_us;
+  float temperature;
+  float pressure;
+  float humidity;
+};
+
+static void run(MS8607 &sensor, struct result *r)
+{
+  float t = 0, p = 0, h = 0;
+
+  sensor.set_pressure_resolution((enum MS8607_pressure_resolution)r->osr);
+  sensor.set_humidity_resolution((enum MS8607_humidity_resolution)r->rh);
+  sensor.set_humidity_i2c_master_mode((enum MS8607_humidity_i2c_master_mode)r->master_mode);
+
+  // One warm up sample so settings and learned timings are in place
+  sensor.read_temperature_pressure_humidity(&t, &p, &h);
+
+  Wire.resetCounters();
+  host_clock_reset_counters();
+  uint64_t start = host_clock_us();
+
+  r->errors = 0;
+  for (uint32_t i = 0; i < r->samples; i++)
+    if (sensor.read_temperature_pressure_humidity(&t, &p, &h) != MS8607_status_ok)
+      r->errors++;
+
+  double n = r->samples;
+  r->wall_us = (host_clock_us() - start) / n;
+  r->transactions = Wire.counters().transactions / n;
+  r->bytes = Wire.counters().bytes / n;
+  r->delay_us = host_delay_us_total() / n;
+  r->temperature = t;
+  r->pressure = p;
+  r->humidity = h;
+}
+
+static void print_csv(const struct result *r, size_t count)
+{
+  printf("osr,rh_resolution,master_mode,samples,errors,wall_us,transactions,bytes,delay_us,"
+         "temperature,pressure,humidity\n");
+  for (size_t i = 0; i < count; i++)
+    printf("%s,%s,%s,%u,%u,%.1f,%.2f,%.2f,%.1f,%.2f,%.3f,%.2f\n",
+           osr_names[r[i].osr], rh_names[r[i].rh], master_mode_names[r[i].master_mode],
+           r[i].samples, r[i].errors, r[i].wall_us, r[i].transactions, r[i].bytes,
+           r[i].delay_us, r[i].temperature, r[i].pressure, r[i].humidity);
+}
+
+static void print_json(const struct result *r, size_t count, uint32_t clock,
+                       bool pipelined, bool adaptive)
+{
+  printf("{\n  \"i2c_clock\": %u,\n  \"acquisition_mode\": \"%s\",\n"
+         "  \"adaptive_timing\": %s,\n  \"results\": [\n",
+         clock, pipelined ? "pipelined" : "sequential", adaptive ? "true" : "false");
+  for (size_t i = 0; i < count; i++)
+    printf("    {\"osr\": %s, \"rh_resolution\": \"%s\", \"master_mode\": \"%s\", "
+           "\"samples\": %u, \"errors\": %u, \"wall_us\": %.1f, \"transactions\": %.2f, "
+           "\"bytes\": %.2f, \"delay_us\": %.1f, \"temperature\": %.2f, "
+           "\"pressure\": %.3f, \"humidity\": %.2f}%s\n",
+           osr_names[r[i].osr], rh_names[r[i].rh], master_mode_names[r[i].master_mode],
+           r[i].samples, r[i].errors, r[i].wall_us, r[i].transactions, r[i].bytes,
+           r[i].delay_us, r[i].temperature, r[i].pressure, r[i].humidity,
+           (i + 1 < count) ? "," : "");
+  printf("  ]\n}\n");
+}
+
+int main(int argc, char **argv)
+{
+  bool json = false;
+  bool pipelined = false;
+  bool adaptive = false;
+  uint32_t samples = 32;
+  uint32_t clock = 100000;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--json") == 0)
+      json = true;
+    else if (strcmp(argv[i], "--pipelined") == 0)
+      pipelined = true;
+    else if (strcmp(argv[i], "--adaptive") == 0)
+      adaptive = true;
+    else if ((strcmp(argv[i], "--samples") == 0) && (i + 1 < argc))
+      samples = strtoul(argv[++i], NULL, 10);
+    else if ((strcmp(argv[i], "--clock") == 0) && (i + 1 < argc))
+      clock = strtoul(argv[++i], NULL, 10);
+    else
+    {
+      fprintf(stderr, "usage: %s [--json] [--samples N] [--clock Hz] [--pipelined] [--adaptive]\n",
+              argv[0]);
+      return 2;
+    }
+  }
+  if (samples == 0)
+    samples = 1;
+
+  MS8607Simulator sim;
+  sim.attach(Wire);
+  sim.setEnvironment(21.5f, 1005.0f, 40.0f);
+  Wire.setClock(clock);
+
+  MS8607 sensor;
+  if (!sensor.begin())
+  {
+    fprintf(stderr, "begin() failed\n");
+    return 1;
+  }
+  sensor.set_acquisition_mode(pipelined ? MS8607_acquisition_pipelined
+                                        : MS8607_acquisition_sequential);
+  sensor.set_adaptive_timing(adaptive);
+
+  struct result results[6 * 4 * 2];
+  size_t count = 0;
+  for (uint8_t osr = 0; osr < 6; osr++)
+    for (uint8_t rh = 0; rh < 4; rh++)
+      for (uint8_t master_mode = 0; master_mode < 2; master_mode++)
+      {
+        struct result *r = &results[count++];
+        r->osr = osr;
+        r->rh = rh;
+        r->master_mode = master_mode;
+        r->samples = samples;
+        run(sensor, r);
+      }
+
+  if (json)
+    print_json(results, count, clock, pipelined, adaptive);
+  else
+    print_csv(results, count);
+
+  for (size_t i = 0; i < count; i++)
+    if (results[i].errors)
+      return 1;
+  return 0;
+}
@@ -0,0 +1,339 @@
+/*
+  Accuracy and speed of the fast altitude and dew point formulas
+  (SparkFun_PHT_MS8607_FastMath) against pow() and log10() on the host.
+
+  Accuracy: every pair of pressures from 10 to 1200mbar on a grid for the
+  altitude change, every pressure from 10 to 1200mbar and altitude from
+  -500m to 30km for the sea level pressure, compared to pow() in double (the
+  driver formulas), next to the same formulas with powf() in float. The
+  fixed point functions round their results to 1cm or 1Pa.
+
+  The dew point is compared to the formula of get_dew_point() in double, for
+  temperatures from -40 to 125C and humidities from 0.01 to 100%RH, on the
+  same grid or, with --exhaustive, for every pair of 0.01C and 0.01%RH (every
+  input of MS8607_dew_point_fixed(), about 20s). The get_dew_point()
+  formula in float shows what the driver computes on AVR, where double is
+  float.
+
+  Speed: ns per call of each function, and of the driver formulas in double
+  and in float (powf), on arrays of samples.
+
+  usage: fastmath_benchmark [--steps N] [--exhaustive] [--samples N] [--runs N]
+
+  The functions only need the PROGMEM macros of the Arduino shim:
+
+    g++ -std=gnu++11 -O2 -Iextras/host -Isrc -include Arduino.h \
+      extras/host/fastmath_benchmark.cpp \
+      src/SparkFun_PHT_MS8607_FastMath.cpp -o fastmath_benchmark
+*/
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "SparkFun_PHT_MS8607_FastMath.h"
+
+#define MIN_PRESSURE 10.0   // mbar
+#define MAX_PRESSURE 1200.0 // mbar
+#define MIN_ALTITUDE -500.0 // m
+#define MAX_ALTITUDE 30000.0
+#define MIN_TEMPERATURE -4000 // 0.01 degC
+#define MAX_TEMPERATURE 12500
+#define MIN_HUMIDITY 1 // 0.01 %RH
+#define MAX_HUMIDITY 10000
+
+// HSENSOR_CONSTANT_A, B and C of the driver
+#define DEW_POINT_A 8.1332
+#define DEW_POINT_B 1762.39
+#define DEW_POINT_C 235.66
+
+static double altitude_change(double pressure, double baseline)
+{
+  return 44330.0 * (1 - pow(pressure / baseline, 1 / 5.255));
+}
+
+static double sea_level_pressure(double pressure, double altitude)
+{
+  return pressure / pow(1 - (altitude / 44330.0), 5.255);
+}
+
+// get_dew_point()
+static double dew_point(double temperature, double humidity)
+{
+  double partial_pressure = pow(10, DEW_POINT_A - DEW_POINT_B / (temperature + DEW_POINT_C));
+
+  return -DEW_POINT_B / (log10(humidity * partial_pressure / 100) - DEW_POINT_A) - DEW_POINT_C;
+}
+
+// get_dew_point() where double is float
+static float dew_point_float(float temperature, float humidity)
+{
+  float partial_pressure =
+      powf(10, (float)DEW_POINT_A - (float)DEW_POINT_B / (temperature + (float)DEW_POINT_C));
+
+  return -(float)DEW_POINT_B / (log10f(humidity * partial_pressure / 100) - (float)DEW_POINT_A) -
+         (float)DEW_POINT_C;
+}
+
+struct error
+{
+  double absolute;
+  double relative;
+  double at_x, at_y;
+};
+
+static void track(struct error *e, double value, double exact, double x, double y)
+{
+  double absolute = fabs(value - exact);
+  double relative = (fabs(exact) >= 1) ? absolute / fabs(exact) : 0;
+
+  if (absolute > e->absolute)
+  {
+    e->absolute = absolute;
+    e->at_x = x;
+    e->at_y = y;
+  }
+  if (relative > e->relative)
+    e->relative = relative;
+}
+
+static void print_error(const char *name, const struct error *e, const char *unit)
+{
+  printf("%-38s max %.3g%s, %.3g of values above 1%s, worst at %.2f, %.2f\n", name,
+         e->absolute, unit, e->relative, unit, e->at_x, e->at_y);
+}
+
+static volatile float float_sink;
+static volatile int32_t fixed_sink;
+
+// ns per call of body(), which makes count calls
+template <class Body>
+static void time_calls(const char *name, size_t count, unsigned runs, Body body)
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (unsigned r = 0; r < runs; r++)
+    body();
+  double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  printf("%-38s %7.2f ns/call\n", name, seconds * 1e9 / ((double)count * runs));
+}
+
+int main(int argc, char **argv)
+{
+  unsigned steps = 2000;
+  size_t samples = 4096;
+  unsigned runs = 200;
+  bool exhaustive = false;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if ((strcmp(argv[i], "--steps") == 0) && (i + 1 < argc))
+      steps = strtoul(argv[++i], NULL, 10);
+    else if (strcmp(argv[i], "--exhaustive") == 0)
+      exhaustive = true;
+    else if ((strcmp(argv[i], "--samples") == 0) && (i + 1 < argc))
+      samples = strtoul(argv[++i], NULL, 10);
+    else if ((strcmp(argv[i], "--runs") == 0) && (i + 1 < argc))
+      runs = strtoul(argv[++i], NULL, 10);
+    else
+    {
+      fprintf(stderr, "usage: %s [--steps N] [--exhaustive] [--samples N] [--runs N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (steps < 2)
+    steps = 2;
+  if (samples == 0)
+    samples = 1;
+  if (runs == 0)
+    runs = 1;
+
+  // Accuracy
+  struct error altitude_float = {0, 0, 0, 0}, altitude_fixed = {0, 0, 0, 0};
+  struct error sea_level_float = {0, 0, 0, 0}, sea_level_fixed = {0, 0, 0, 0};
+  struct error altitude_powf = {0, 0, 0, 0}, sea_level_powf = {0, 0, 0, 0};
+
+  for (unsigned i = 0; i < steps; i++)
+  {
+    // Pa on the grid, exact in both float and int32_t
+    double pressure =
+        floor((MIN_PRESSURE + (MAX_PRESSURE - MIN_PRESSURE) * i / (steps - 1)) * 100) / 100;
+
+    for (unsigned j = 0; j < steps; j++)
+    {
+      double baseline =
+          floor((MIN_PRESSURE + (MAX_PRESSURE - MIN_PRESSURE) * j / (steps - 1)) * 100) / 100;
+      double altitude =
+          floor((MIN_ALTITUDE + (MAX_ALTITUDE - MIN_ALTITUDE) * j / (steps - 1)) * 100) / 100;
+      double exact;
+
+      exact = altitude_change(pressure, baseline);
+      track(&altitude_float, MS8607_altitude_change_fast((float)pressure, (float)baseline),
+            exact, pressure, baseline);
+      track(&altitude_fixed,
+            MS8607_altitude_change_fixed(lround(pressure * 100), lround(baseline * 100)) / 100.0,
+            exact, pressure, baseline);
+
+      track(&altitude_powf,
+            44330.0f * (1.0f - powf((float)pressure / (float)baseline, 1.0f / 5.255f)),
+            exact, pressure, baseline);
+
+      exact = sea_level_pressure(pressure, altitude);
+      track(&sea_level_powf,
+            (float)pressure / powf(1.0f - (float)altitude / 44330.0f, 5.255f),
+            exact, pressure, altitude);
+      track(&sea_level_float, MS8607_sea_level_pressure_fast((float)pressure, (float)altitude),
+            exact, pressure, altitude);
+      track(&sea_level_fixed,
+            MS8607_sea_level_pressure_fixed(lround(pressure * 100), lround(altitude * 100)) / 100.0,
+            exact, pressure, altitude);
+    }
+  }
+
+  printf("Maximum error against pow() in double, %u x %u points\n", steps, steps);
+  print_error("altitudeChange (powf, float)", &altitude_powf, "m");
+  print_error("MS8607_altitude_change_fast", &altitude_float, "m");
+  print_error("MS8607_altitude_change_fixed", &altitude_fixed, "m");
+  print_error("adjustToSeaLevel (powf, float)", &sea_level_powf, "mbar");
+  print_error("MS8607_sea_level_pressure_fast", &sea_level_float, "mbar");
+  print_error("MS8607_sea_level_pressure_fixed", &sea_level_fixed, "mbar");
+
+  struct error dew_point_powf = {0, 0, 0, 0}, dew_point_float_error = {0, 0, 0, 0};
+  struct error dew_point_fixed = {0, 0, 0, 0};
+  int32_t temperature_step = 1, humidity_step = 1;
+
+  if (!exhaustive)
+  {
+    temperature_step = (MAX_TEMPERATURE - MIN_TEMPERATURE) / (steps - 1);
+    humidity_step = (MAX_HUMIDITY - MIN_HUMIDITY) / (steps - 1);
+    if (temperature_step == 0)
+      temperature_step = 1;
+    if (humidity_step == 0)
+      humidity_step = 1;
+  }
+
+  for (int32_t t = MIN_TEMPERATURE; t <= MAX_TEMPERATURE; t += temperature_step)
+  {
+    for (int32_t h = MIN_HUMIDITY; h <= MAX_HUMIDITY; h += humidity_step)
+    {
+      double temperature = t / 100.0, humidity = h / 100.0;
+      double exact = dew_point(temperature, humidity);
+
+      track(&dew_point_powf, dew_point_float((float)temperature, (float)humidity),
+            exact, temperature, humidity);
+      track(&dew_point_float_error, MS8607_dew_point_fast((float)temperature, (float)humidity),
+            exact, temperature, humidity);
+      track(&dew_point_fixed, MS8607_dew_point_fixed(t, h) / 100.0,
+            exact, temperature, humidity);
+    }
+  }
+
+  printf("\nMaximum dew point error against get_dew_point() in double, %s\n",
+         exhaustive ? "every 0.01C x 0.01%RH" : "grid");
+  print_error("get_dew_point (powf, log10f, float)", &dew_point_powf, "C");
+  print_error("MS8607_dew_point_fast", &dew_point_float_error, "C");
+  print_error("MS8607_dew_point_fixed", &dew_point_fixed, "C");
+
+  // Speed
+  std::vector<float> pressure(samples), altitude(samples), output(samples);
+  std::vector<int32_t> pressure_pa(samples), altitude_cm(samples), output_fixed(samples);
+  float baseline = 1013.25f;
+  int32_t baseline_pa = 101325;
+
+  for (size_t i = 0; i < samples; i++)
+  {
+    pressure[i] = (float)(MIN_PRESSURE + (MAX_PRESSURE - MIN_PRESSURE) * i / samples);
+    altitude[i] = (float)(MIN_ALTITUDE + (MAX_ALTITUDE - MIN_ALTITUDE) * i / samples);
+    pressure_pa[i] = lround(pressure[i] * 100);
+    altitude_cm[i] = lround(altitude[i] * 100);
+  }
+
+  printf("\nSpeed, %zu samples x %u runs\n", samples, runs);
+  time_calls("altitudeChange (pow, double)", samples, runs, [&]() {
+    for (size_t i = 0; i < samples; i++)
+      float_sink = (float)altitude_change(pressure[i], baseline);
+  });
+  time_calls("altitudeChange (powf, float)", samples, runs, [&]() {
+    for (size_t i = 0; i < samples; i++)
+      float_sink = 44330.0f * (1.0f - powf(pressure[i] / baseline, 1.0f / 5.255f));
+  });
+  time_calls("MS8607_altitude_change_fast", samples, runs, [&]() {
+    for (size_t i = 0; i < samples; i++)
+      float_sink = MS8607_altitude_change_fast(pressure[i], baseline);
+  });
+  time_calls("MS8607_altitude_change_fast_batch", samples, runs, [&]() {
+    MS8607_altitude_change_fast_batch(&pressure[0], baseline, &output[0], samples);
+  });
+  time_calls("MS8607_altitude_change_fixed", samples, runs, [&]() {
+    for (size_t i = 0; i < samples; i++)
+      fixed_sink = MS8607_altitude_change_fixed(pressure_pa[i], baseline_pa);
+  });
+  time_calls("MS8607_altitude_change_fixed_batch", samples, runs, [&]() {
+    MS8607_altitude_change_fixed_batch(&pressure_pa[0], baseline_pa, &output_fixed[0], samples);
+  });
+
+  time_calls("adjustToSeaLevel (pow, double)", samples, runs, [&]() {
+    for (size_t i = 0; i < samples; i++)
+      float_sink = (float)sea_level_pressure(pressure[i], altitude[i]);
+  });
+  time_calls("adjustToSeaLevel (powf, float)", samples, runs, [&]() {
+    for (size_t i = 0; i < samples; i++)
+      float_sink = pressure[i] / powf(1.0f - altitude[i] / 44330.0f, 5.255f);
+  });
+  time_calls("MS8607_sea_level_pressure_fast", samples, runs, [&]() {
+    for (size_t i = 0; i < samples; i++)
+      float_sink = MS8607_sea_level_pressure_fast(pressure[i], altitude[i]);
+  });
+  time_calls("MS8607_sea_level_pressure_fast_batch", samples, runs, [&]() {
+    MS8607_sea_level_pressure_fast_batch(&pressure[0], &altitude[0], &output[0], samples);
+  });
+  time_calls("MS8607_sea_level_pressure_fixed", samples, runs, [&]() {
+    for (size_t i = 0; i < samples; i++)
+      fixed_sink = MS8607_sea_level_pressure_fixed(pressure_pa[i], altitude_cm[i]);
+  });
+  time_calls("MS8607_sea_level_pressure_fixed_batch", samples, runs, [&]() {
+    MS8607_sea_level_pressure_fixed_batch(&pressure_pa[0], &altitude_cm[0], &output_fixed[0], samples);
+  });
+
+  std::vector<float> temperature(samples), humidity(samples);
+  std::vector<int32_t> temperature_fixed(samples), humidity_fixed(samples);
+
+  for (size_t i = 0; i < samples; i++)
+  {
+    temperature_fixed[i] = MIN_TEMPERATURE + (int32_t)((MAX_TEMPERATURE - MIN_TEMPERATURE) * i / samples);
+    humidity_fixed[i] = MIN_HUMIDITY + (int32_t)((MAX_HUMIDITY - MIN_HUMIDITY) * ((i * 7919) % samples) / samples);
+    temperature[i] = temperature_fixed[i] / 100.0f;
+    humidity[i] = humidity_fixed[i] / 100.0f;
+  }
+
+  time_calls("get_dew_point (pow, log10, double)", samples, runs, [&]() {
+    for (size_t i = 0; i < samples; i++)
+      float_sink = (float)dew_point(temperature[i], humidity[i]);
+  });
+  time_calls("get_dew_point (powf, log10f, float)", samples, runs, [&]() {
+    for (size_t i = 0; i < samples; i++)
+      float_sink = dew_point_float(temperature[i], humidity[i]);
+  });
+  time_calls("MS8607_dew_point_fast", samples, runs, [&]() {
+    for (size_t i = 0; i < samples; i++)
+      float_sink = MS8607_dew_point_fast(temperature[i], humidity[i]);
+  });
+  time_calls("MS8607_dew_point_fast_batch", samples, runs, [&]() {
+    MS8607_dew_point_fast_batch(&temperature[0], &humidity[0], &output[0], samples);
+  });
+  time_calls("MS8607_dew_point_fixed", samples, runs, [&]() {
+    for (size_t i = 0; i < samples; i++)
+      fixed_sink = MS8607_dew_point_fixed(temperature_fixed[i], humidity_fixed[i]);
+  });
+  time_calls("MS8607_dew_point_fixed_batch", samples, runs, [&]() {
+    MS8607_dew_point_fixed_batch(&temperature_fixed[0], &humidity_fixed[0], &output_fixed[0], samples);
+  });
+
+  float_sink = output[samples / 2];
+  fixed_sink = output_fixed[samples / 2];
+
+  return 0;
+}
@@ -0,0 +1,190 @@
+/*
+  Host implementations of the Arduino core functions and TwoWire used by the
+  MS8607 simulator builds.
+*/
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include <stdio.h>
+
+static uint64_t clock_us = 0;
+static uint64_t delay_us_total = 0;
+static uint8_t pin_state[64];
+
+uint64_t host_clock_us(void) { return clock_us; }
+void host_clock_advance_us(uint64_t us) { clock_us += us; }
+uint64_t host_delay_us_total(void) { return delay_us_total; }
+void host_clock_reset_counters(void) { delay_us_total = 0; }
+
+unsigned long micros(void)
+{
+  clock_us++;
+  return (unsigned long)(uint32_t)clock_us;
+}
+
+unsigned long millis(void)
+{
+  clock_us++;
+  return (unsigned long)(uint32_t)(clock_us / 1000);
+}
+
+void delay(unsigned long ms)
+{
+  clock_us += (uint64_t)ms * 1000;
+  delay_us_total += (uint64_t)ms * 1000;
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  clock_us += us;
+  delay_us_total += us;
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  if ((pin < sizeof(pin_state)) && (mode == INPUT_PULLUP))
+    pin_state[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+  if (pin < sizeof(pin_state))
+    pin_state[pin] = val;
+}
+
+int digitalRead(uint8_t pin)
+{
+  return (pin < sizeof(pin_state)) ? pin_state[pin] : HIGH;
+}
+
+void noInterrupts(void) {}
+void interrupts(void) {}
+
+HardwareSerial Serial;
+
+size_t HardwareSerial::write(uint8_t c) { return fwrite(&c, 1, 1, stdout); }
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) { return fwrite(buffer, 1, size, stdout); }
+size_t HardwareSerial::print(const char *s) { return fputs(s, stdout) < 0 ? 0 : strlen(s); }
+size_t HardwareSerial::print(char c) { return write((uint8_t)c); }
+size_t HardwareSerial::print(long n, int base) { return printf(base == HEX ? "%lX" : "%ld", n); }
+size_t HardwareSerial::print(unsigned long n, int base) { return printf(base == HEX ? "%lX" : "%lu", n); }
+size_t HardwareSerial::print(long long n, int base) { return printf(base == HEX ? "%llX" : "%lld", n); }
+size_t HardwareSerial::print(unsigned long long n, int base) { return printf(base == HEX ? "%llX" : "%llu", n); }
+size_t HardwareSerial::print(double n, int digits) { return printf("%.*f", digits, n); }
+size_t HardwareSerial::println(void) { return print("\r\n"); }
+
+TwoWire Wire;
+
+TwoWire::TwoWire()
+    : _clock(100000), _txAddress(0), _txLength(0), _txOverflow(false),
+      _rxLength(0), _rxIndex(0)
+{
+  memset(_targets, 0, sizeof(_targets));
+  memset(&_counters, 0, sizeof(_counters));
+}
+
+void TwoWire::begin(void) {}
+void TwoWire::end(void) {}
+void TwoWire::setClock(uint32_t clock) { _clock = clock; }
+
+void TwoWire::attach(uint8_t address, TwoWireTarget *target)
+{
+  _targets[address & 0x7F] = target;
+}
+
+void TwoWire::detach(uint8_t address) { _targets[address & 0x7F] = NULL; }
+
+void TwoWire::resetCounters(void) { memset(&_counters, 0, sizeof(_counters)); }
+
+// Start + (address + data bytes) * 9 bits + stop, at the configured SCL rate
+void TwoWire::account(size_t bytes)
+{
+  uint64_t us = ((2 + (uint64_t)bytes * 9) * 1000000ULL + _clock - 1) / _clock;
+  _counters.transactions++;
+  _counters.bytes += bytes;
+  _counters.bus_us += us;
+  clock_us += us;
+}
+
+void TwoWire::beginTransmission(uint8_t address)
+{
+  _txAddress = address & 0x7F;
+  _txLength = 0;
+  _txOverflow = false;
+}
+
+size_t TwoWire::write(uint8_t data)
+{
+  if (_txLength >= sizeof(_txBuffer))
+  {
+    _txOverflow = true;
+    return 0;
+  }
+  _txBuffer[_txLength++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t length)
+{
+  size_t i;
+  for (i = 0; i < length; i++)
+    if (write(data[i]) == 0)
+      break;
+  return i;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop)
+{
+  (void)sendStop;
+  TwoWireTarget *target = _targets[_txAddress];
+
+  if (_txOverflow)
+    return 1;
+  if (target == NULL)
+  {
+    account(1);
+    _counters.nacks++;
+    return 2;
+  }
+  account(1 + _txLength);
+  if (!target->onWrite(_txBuffer, _txLength))
+  {
+    _counters.nacks++;
+    return 3;
+  }
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, bool sendStop)
+{
+  (void)sendStop;
+  TwoWireTarget *target = _targets[address & 0x7F];
+
+  _rxIndex = 0;
+  _rxLength = 0;
+  if (quantity > sizeof(_rxBuffer))
+    quantity = sizeof(_rxBuffer);
+  if (target != NULL)
+    _rxLength = target->onRead(_rxBuffer, quantity);
+  account(1 + _rxLength);
+  if (_rxLength == 0)
+    _counters.nacks++;
+  return (uint8_t)_rxLength;
+}
+
+int TwoWire::available(void) { return (int)(_rxLength - _rxIndex); }
+
+int TwoWire::read(void)
+{
+  if (_rxIndex >= _rxLength)
+    return -1;
+  return _rxBuffer[_rxIndex++];
+}
+
+int TwoWire::peek(void)
+{
+  if (_rxIndex >= _rxLength)
+    return -1;
+  return _rxBuffer[_rxIndex];
+}
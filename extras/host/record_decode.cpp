@@ -0,0 +1,92 @@
+/*
+  Convert a binary log written with MS8607_record_encode() to CSV.
+
+  Prints one line per record: timestamp in ms, temperature in 0.01 degC,
+  pressure in Pa and humidity in 0.01 %RH (empty when the channel was not
+  logged), and the PROM words of every keyframe as a comment. Undecodable
+  bytes are skipped up to the next keyframe whose PROM words pass the CRC-4
+  and whose check byte matches. Once a keyframe has been decoded, a keyframe
+  found after skipped bytes must also hold the same PROM words.
+
+  usage: record_decode < log.bin > log.csv
+
+    g++ -std=gnu++11 -O2 -Iextras/host -Isrc -include Arduino.h \
+      extras/host/record_decode.cpp src/SparkFun_PHT_MS8607_Record.cpp \
+      src/SparkFun_PHT_MS8607_CRC.cpp -o record_decode
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "SparkFun_PHT_MS8607_Record.h"
+
+int main(void)
+{
+  std::vector<uint8_t> log;
+  struct MS8607_record_codec decoder;
+  struct MS8607_record record;
+  uint16_t coeff[7];
+  bool known = false, resyncing = false;
+  size_t position = 0, skipped = 0;
+  int c, used;
+
+  while ((c = getchar()) != EOF)
+    log.push_back(c);
+
+  MS8607_record_decoder_init(&decoder);
+  printf("timestamp,temperature,pressure,humidity\n");
+
+  while (position < log.size())
+  {
+    used = MS8607_record_decode(&decoder, &log[position], log.size() - position,
+                                &record);
+    if (used == 0)
+      break; // Truncated last record
+    // After a skip, a keyframe of another PROM is bytes that happen to pass
+    // the checks: the device of a log does not change
+    if ((used > 0) && record.keyframe && resyncing && known &&
+        (memcmp(coeff, decoder.coeff, sizeof(coeff)) != 0))
+      used = -1;
+    if (used < 0)
+    {
+      // Resynchronise on the next keyframe
+      MS8607_record_decoder_init(&decoder);
+      position++;
+      skipped++;
+      resyncing = true;
+      continue;
+    }
+    position += used;
+
+    if (record.keyframe)
+    {
+      memcpy(coeff, decoder.coeff, sizeof(coeff));
+      known = true;
+      resyncing = false;
+
+      printf("# PROM");
+      for (int i = 0; i < 7; i++)
+        printf(" %u", decoder.coeff[i]);
+      printf("\n");
+    }
+
+    printf("%lu,", (unsigned long)record.timestamp);
+    if (record.channels & 0x02)
+      printf("%ld", (long)record.temperature);
+    printf(",");
+    if (record.channels & 0x01)
+      printf("%ld", (long)record.pressure);
+    printf(",");
+    if (record.channels & 0x04)
+      printf("%ld", (long)record.humidity);
+    printf("\n");
+  }
+
+  if (skipped != 0)
+    fprintf(stderr, "%zu bytes skipped\n", skipped);
+  if (position < log.size())
+    fprintf(stderr, "%zu bytes of a truncated record ignored\n", log.size() - position);
+
+  return 0;
+}
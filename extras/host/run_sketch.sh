@@ -0,0 +1,15 @@
+#!/bin/sh
+# Build and run an example sketch on the host against the simulated MS8607.
+# usage: run_sketch.sh path/to/Sketch.ino [virtual ms, default 2000]
+#        [sensors behind TCA9548A muxes, default 0: one sensor on the bus]
+set -e
+here=$(cd "$(dirname "$0")" && pwd)
+src="$here/../../src"
+sketch=$1
+shift
+out=${TMPDIR:-/tmp}/ms8607_sketch
+${CXX:-g++} -std=gnu++11 -O2 -Wall -I"$here" -I"$src" -include Arduino.h \
+  -x c++ "$sketch" -x none \
+  "$here/run_sketch_main.cpp" "$here/MS8607_Simulator.cpp" "$here/host_arduino.cpp" \
+  "$here/TCA9548A_Simulator.cpp" "$src"/*.cpp -o "$out"
+"$out" "$@"
@@ -0,0 +1,44 @@
+// Runs a sketch against the simulator for a fixed amount of virtual time (ms).
+// With a sensor count, that many simulated sensors sit behind TCA9548A muxes
+// at the default locations of MS8607_Manager instead: channel i % 8 of mux
+// 0x70, 0x71, ... 0x75, 0x77.
+#include <stdio.h>
+#include "MS8607_Simulator.h"
+#include "TCA9548A_Simulator.h"
+void setup(void);
+void loop(void);
+int main(int argc, char **argv)
+{
+  uint64_t run_us = (argc > 1 ? strtoull(argv[1], NULL, 10) : 2000) * 1000ULL;
+  unsigned count = (argc > 2 ? strtoul(argv[2], NULL, 10) : 0);
+  if (count > 56)
+    count = 56;
+
+  MS8607Simulator sim[56];
+  TCA9548ASimulator muxes;
+  if (count == 0)
+    sim[0].attach(Wire);
+  for (unsigned i = 0; i < count; i++)
+  {
+    uint8_t mux = 0x70 + i / 8;
+    if (mux >= 0x76)
+      mux++;
+    if (i % 8 == 0)
+      muxes.attachMux(Wire, mux);
+    // A slightly different device and environment each
+    sim[i].setPromWord(1, sim[i].prom()[1] + i * 17);
+    sim[i].setEnvironment(21.0f + i * 0.5f, 1005.0f - i * 0.25f, 40.0f + i);
+    muxes.attachDevice(Wire, mux, i % 8, 0x76, sim[i].pressureDie());
+    muxes.attachDevice(Wire, mux, i % 8, 0x40, sim[i].humidityDie());
+  }
+
+  setup();
+  while (host_clock_us() < run_us)
+  {
+    loop();
+    host_clock_advance_us(1); // An empty loop() still ends
+  }
+  if (muxes.conflicts())
+    fprintf(stderr, "%u address conflicts behind the muxes\n", (unsigned)muxes.conflicts());
+  return 0;
+}
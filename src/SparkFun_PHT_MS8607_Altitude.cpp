@@ -0,0 +1,109 @@
+#include "SparkFun_PHT_MS8607_Altitude.h"
+#include "SparkFun_PHT_MS8607_FastMath.h"
+
+// Covariance elements
+#define P00 0
+#define P01 1
+#define P02 2
+#define P11 3
+#define P12 4
+#define P22 5
+
+// Initial uncertainty of the speed (m/s) and acceleration (m/s^2), squared
+#define INITIAL_VELOCITY_VARIANCE 100.0f
+#define INITIAL_ACCELERATION_VARIANCE 10.0f
+
+void MS8607_altitude_init(struct MS8607_altitude_estimator *estimator,
+                          float altitude_noise, float jerk_noise,
+                          int32_t reference_pressure)
+{
+  uint8_t i;
+
+  estimator->altitude = 0;
+  estimator->velocity = 0;
+  estimator->acceleration = 0;
+  for (i = 0; i < 6; i++)
+    estimator->covariance[i] = 0;
+  estimator->reference_pressure = reference_pressure;
+  estimator->altitude_variance = altitude_noise * altitude_noise;
+  estimator->jerk_variance = jerk_noise * jerk_noise;
+  estimator->timestamp = 0;
+  estimator->started = false;
+}
+
+// x = F x, P = F P F' + Q for F = [1 dt dt^2/2; 0 1 dt; 0 0 1] and white jerk
+static void predict(struct MS8607_altitude_estimator *e, float dt)
+{
+  float *p = e->covariance;
+  float half = 0.5f * dt * dt;
+  float q = e->jerk_variance;
+  float dt2 = dt * dt, dt3 = dt2 * dt;
+  float r00, r01, r02, r11, r12;
+
+  e->altitude += dt * e->velocity + half * e->acceleration;
+  e->velocity += dt * e->acceleration;
+
+  // Rows of F P
+  r00 = p[P00] + dt * p[P01] + half * p[P02];
+  r01 = p[P01] + dt * p[P11] + half * p[P12];
+  r02 = p[P02] + dt * p[P12] + half * p[P22];
+  r11 = p[P11] + dt * p[P12];
+  r12 = p[P12] + dt * p[P22];
+
+  // (F P) F' + Q
+  p[P00] = r00 + dt * r01 + half * r02 + q * dt3 * dt2 / 20;
+  p[P01] = r01 + dt * r02 + q * dt2 * dt2 / 8;
+  p[P02] = r02 + q * dt3 / 6;
+  p[P11] = r11 + dt * r12 + q * dt3 / 3;
+  p[P12] = r12 + q * dt2 / 2;
+  p[P22] = p[P22] + q * dt;
+}
+
+void MS8607_altitude_update(struct MS8607_altitude_estimator *estimator,
+                            int32_t pressure, uint32_t timestamp)
+{
+  struct MS8607_altitude_estimator *e = estimator;
+  float *p = e->covariance;
+  float z, s, k0, k1, k2, innovation;
+
+  if (pressure <= 0)
+    return;
+
+  if (e->reference_pressure <= 0)
+    e->reference_pressure = pressure;
+  z = MS8607_altitude_change_fast(pressure, e->reference_pressure);
+
+  if (!e->started)
+  {
+    e->altitude = z;
+    p[P00] = e->altitude_variance;
+    p[P11] = INITIAL_VELOCITY_VARIANCE;
+    p[P22] = INITIAL_ACCELERATION_VARIANCE;
+    e->timestamp = timestamp;
+    e->started = true;
+    return;
+  }
+
+  if (timestamp != e->timestamp)
+    predict(e, (uint32_t)(timestamp - e->timestamp) * 0.001f);
+  e->timestamp = timestamp;
+
+  // Measurement of the altitude only: K = P H' / (H P H' + R), H = [1 0 0]
+  s = p[P00] + e->altitude_variance;
+  k0 = p[P00] / s;
+  k1 = p[P01] / s;
+  k2 = p[P02] / s;
+
+  innovation = z - e->altitude;
+  e->altitude += k0 * innovation;
+  e->velocity += k1 * innovation;
+  e->acceleration += k2 * innovation;
+
+  // P = (I - K H) P
+  p[P11] -= k1 * p[P01];
+  p[P12] -= k1 * p[P02];
+  p[P22] -= k2 * p[P02];
+  p[P01] -= k0 * p[P01];
+  p[P02] -= k0 * p[P02];
+  p[P00] -= k0 * p[P00];
+}
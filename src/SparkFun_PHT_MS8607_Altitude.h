@@ -0,0 +1,66 @@
+/*
+  Streaming altitude and vertical speed estimator for the MS8607.
+
+  A constant acceleration Kalman filter on the barometric altitude. Each
+  pressure sample is converted to an altitude with the same formula as
+  altitudeChange() and fused with the prediction of the state (altitude,
+  vertical speed, vertical acceleration) from the previous sample. The
+  samples carry their own timestamp, so they can arrive at any rate, even
+  irregularly, and every update costs the same few dozen float operations
+  with fixed memory.
+
+  Tuning:
+    - altitude_noise : standard deviation of the altitude of a single
+      sample in m. About 0.15m at OSR 8192, 1m at OSR 256.
+    - jerk_noise : how fast the acceleration may change, in m/s^3 per
+      square root of a second (white jerk). Small values (0.1) give a
+      smooth, slow estimate (weather balloon), large values (10) follow a
+      drone closely but let more noise through.
+
+  MIT License, see SparkFun_PHT_MS8607_Arduino_Library.h
+*/
+
+#ifndef MS8607_ALTITUDE_H
+#define MS8607_ALTITUDE_H
+
+#include <stdint.h>
+
+struct MS8607_altitude_estimator
+{
+       float altitude;     // m above the reference pressure
+       float velocity;     // m/s, positive when climbing
+       float acceleration; // m/s^2
+       float covariance[6]; // Upper triangle of the 3x3 state covariance: 00 01 02 11 12 22
+       float reference_pressure; // Pa at 0m, 0 = the first sample
+       float altitude_variance;  // altitude_noise^2
+       float jerk_variance;      // jerk_noise^2
+       uint32_t timestamp;       // ms of the last sample
+       bool started;             // A sample has been used
+};
+
+/*
+  \brief Set up an estimator. The first sample sets the altitude; the speed
+         and the acceleration start at 0.
+
+  \param[out] MS8607_altitude_estimator* : Estimator
+  \param[in] float : Altitude noise of a sample, m
+  \param[in] float : Jerk noise, m/s^3/sqrt(s)
+  \param[in] int32_t : Pressure at 0m in Pa, e.g. 101325 for the altitude
+         above sea level, or 0 to measure from the first sample
+*/
+void MS8607_altitude_init(struct MS8607_altitude_estimator *estimator,
+                          float altitude_noise, float jerk_noise,
+                          int32_t reference_pressure);
+
+/*
+  \brief Add a pressure sample. Samples with the same timestamp as the
+         previous one are fused without any prediction step.
+
+  \param[in,out] MS8607_altitude_estimator* : Estimator
+  \param[in] int32_t : Pressure in Pa (0.01 mbar), as returned by the _fixed API
+  \param[in] uint32_t : Timestamp of the sample, ms (e.g. millis())
+*/
+void MS8607_altitude_update(struct MS8607_altitude_estimator *estimator,
+                            int32_t pressure, uint32_t timestamp);
+
+#endif
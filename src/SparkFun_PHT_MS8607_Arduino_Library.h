@@ -50,6 +50,19 @@
 
 #include "Wire.h"
 
+#include "SparkFun_PHT_MS8607_Altitude.h"
+#include "SparkFun_PHT_MS8607_CRC.h"
+#include "SparkFun_PHT_MS8607_Compensation.h"
+#include "SparkFun_PHT_MS8607_FastMath.h"
+#include "SparkFun_PHT_MS8607_Filter.h"
+#include "SparkFun_PHT_MS8607_Record.h"
+
+// Uncomment, or define for the whole build (e.g. -DMS8607_ENABLE_STATS), to
+// record bus operation counters and latency histograms, see getStats().
+// It changes the size of the class, so the library and the sketch must be
+// built with the same setting.
+//#define MS8607_ENABLE_STATS
+
 // Platform specific configurations
 // Define Serial for SparkFun SAMD based boards.
 // You may need to adapt these lines if your SAMD board supports Serial (not SerialUSB)
@@ -169,9 +182,12 @@ enum MS8607_status
        MS8607_status_no_i2c_acknowledge,
        MS8607_status_i2c_transfer_error,
        MS8607_status_crc_error,
-       MS8607_status_heater_on_error
+       MS8607_status_heater_on_error,
+       MS8607_status_busy
 };
 
+#define MS8607_STATUS_COUNT (MS8607_status_busy + 1)
+
 enum MS8607_humidity_resolution
 {
        MS8607_humidity_resolution_12b = 0,
@@ -202,6 +218,228 @@ enum MS8607_pressure_resolution
        MS8607_pressure_resolution_osr_8192
 };
 
+enum MS8607_acquisition_state
+{
+       MS8607_acquisition_idle,
+       MS8607_acquisition_temperature_conversion,
+       MS8607_acquisition_pressure_conversion,
+       MS8607_acquisition_humidity_conversion,
+       MS8607_acquisition_complete,
+       MS8607_acquisition_error
+};
+
+enum MS8607_acquisition_mode
+{
+       MS8607_acquisition_sequential,
+       MS8607_acquisition_pipelined
+};
+
+enum MS8607_channel
+{
+       MS8607_channel_pressure = 0x01,
+       MS8607_channel_temperature = 0x02,
+       MS8607_channel_humidity = 0x04,
+       MS8607_channel_all = 0x07
+};
+
+// One coherent temperature, pressure and humidity acquisition
+struct MS8607_sample
+{
+       float temperature;  // degC
+       float pressure;     // mbar
+       float humidity;     // %RH
+       uint32_t timestamp; // millis() when the acquisition completed
+       uint32_t sequence;  // Incremented for every acquisition, 0 = no sample yet
+       uint8_t channels;   // MS8607_channel bits acquired
+};
+
+// The same sample in integer units
+struct MS8607_sample_fixed
+{
+       int32_t temperature; // 0.01 degC
+       int32_t pressure;    // Pa (0.01 mbar)
+       int32_t humidity;    // 0.01 %RH
+       uint32_t timestamp;  // millis() when the acquisition completed
+       uint32_t sequence;   // Incremented for every acquisition, 0 = no sample yet
+       uint8_t channels;    // MS8607_channel bits acquired
+};
+
+// The raw ADC words of an acquisition, compensated later with the PROM
+// coefficients (see get_prom_coefficients() and MS8607_compensate_batch())
+struct MS8607_raw_sample
+{
+       uint32_t adc_pressure;    // D1, 0 if pressure was not acquired
+       uint32_t adc_temperature; // D2, 0 if temperature was not acquired
+       uint16_t adc_humidity;    // RH, 0 if humidity was not acquired
+       uint8_t channels;         // MS8607_channel bits acquired
+};
+
+// Bus operations counted by the statistics
+enum MS8607_operation
+{
+       MS8607_operation_pressure_adc,        // D1/D2 conversion and ADC read
+       MS8607_operation_humidity_adc,        // RH conversion and ADC read
+       MS8607_operation_prom_read,           // One PROM coefficient
+       MS8607_operation_user_register_read,  // Humidity user register read
+       MS8607_operation_user_register_write, // Humidity user register write
+       MS8607_operation_other,               // Resets, probes, serial number (bytes only)
+       MS8607_operation_count
+};
+
+// Latency bucket b counts operations faster than (128us << b), the last
+// bucket counts everything slower
+#define MS8607_STATS_BUCKETS 12
+
+struct MS8607_operation_stats
+{
+       uint32_t count;                        // Completed operations
+       uint32_t status[MS8607_STATUS_COUNT];  // Completions by MS8607_status
+       uint32_t bytes;                        // Data bytes written and read
+       uint32_t latency[MS8607_STATS_BUCKETS]; // Latency histogram
+};
+
+struct MS8607_stats
+{
+       struct MS8607_operation_stats operation[MS8607_operation_count];
+};
+
+// How failed bus transactions are retried and when the bus is recovered.
+// The default (all 0) makes one attempt and never recovers.
+struct MS8607_retry_policy
+{
+       uint8_t retries;      // Extra attempts after a failed transaction
+       uint16_t backoff_us;  // Wait before the first retry, doubled for each retry
+       uint32_t deadline_us; // Give up retrying this long after the first attempt, 0 = no limit
+       uint8_t recover_after; // Failed transactions in a row before bus recovery, reset and PROM reload, 0 = never
+};
+
+// Marks a populated MS8607_prom_cache
+#define MS8607_PROM_CACHE_MAGIC 0x8607
+
+enum MS8607_prom_cache_mode
+{
+       MS8607_prom_cache_verify,        // Read back the CRC word and C1, reload on mismatch.
+                                        // A swapped device passes only if both its 4-bit CRC
+                                        // (1 in 16) and its 16-bit C1 match.
+       MS8607_prom_cache_trust,         // Use a valid cache without any PROM read
+       MS8607_prom_cache_verify_serial  // Compare the serial number, reload on mismatch
+};
+
+// Pressure die PROM coefficients kept across resets (RTC RAM, EEPROM, flash)
+struct MS8607_prom_cache
+{
+       uint16_t magic;                      // MS8607_PROM_CACHE_MAGIC when populated
+       uint16_t coeff[COEFFICIENT_NUMBERS]; // PROM words 0 to 6, CRC in word 0
+       uint64_t serial;                     // readSerialNumber() of the device, 0 if unknown
+};
+
+// Load a cache saved earlier. Return false when nothing is stored.
+typedef bool (*MS8607_prom_cache_load)(struct MS8607_prom_cache *cache,
+                                       void *context);
+// Save a freshly read cache
+typedef void (*MS8607_prom_cache_store)(const struct MS8607_prom_cache *cache,
+                                        void *context);
+
+/*
+  Sample ring
+
+  A fixed capacity single producer / single consumer queue of samples. The
+  producer (e.g. a timer task or ISR driving startMeasurement() and poll())
+  and the consumer (loop()) each own one index and only read the other one,
+  with acquire/release atomics, so neither side ever waits or disables
+  interrupts. When the ring is full the new sample is dropped and counted.
+  The indices are single bytes on AVR, where wider atomic accesses would
+  need the interrupts disabled, so the capacity is limited to 128 there.
+
+  MS8607_ring_base is the interface the driver pushes into (see
+  set_sample_ring()). Declare an MS8607_ring<N>, N a power of 2, for the
+  storage.
+*/
+#if defined(__AVR__)
+typedef uint8_t MS8607_ring_index;
+#else
+typedef uint16_t MS8607_ring_index;
+#endif
+
+class MS8607_ring_base
+{
+public:
+       // Producer: append a sample. Returns false (and counts a drop) if full.
+       bool push(const struct MS8607_sample_fixed *sample)
+       {
+              MS8607_ring_index head = __atomic_load_n(&_head, __ATOMIC_RELAXED);
+              MS8607_ring_index tail = __atomic_load_n(&_tail, __ATOMIC_ACQUIRE);
+
+              if ((MS8607_ring_index)(head - tail) > _mask)
+              {
+                     __atomic_store_n(&_dropped,
+                                      __atomic_load_n(&_dropped, __ATOMIC_RELAXED) + 1,
+                                      __ATOMIC_RELAXED);
+                     return false;
+              }
+
+              _buffer[head & _mask] = *sample;
+              __atomic_store_n(&_head, (MS8607_ring_index)(head + 1), __ATOMIC_RELEASE);
+              return true;
+       }
+
+       // Consumer: remove the oldest sample. Returns false if empty.
+       bool pop(struct MS8607_sample_fixed *sample)
+       {
+              MS8607_ring_index tail = __atomic_load_n(&_tail, __ATOMIC_RELAXED);
+              MS8607_ring_index head = __atomic_load_n(&_head, __ATOMIC_ACQUIRE);
+
+              if (head == tail)
+                     return false;
+
+              *sample = _buffer[tail & _mask];
+              __atomic_store_n(&_tail, (MS8607_ring_index)(tail + 1), __ATOMIC_RELEASE);
+              return true;
+       }
+
+       // Samples waiting, exact for the consumer, a lower bound for the producer
+       MS8607_ring_index available(void) const
+       {
+              return __atomic_load_n(&_head, __ATOMIC_ACQUIRE) -
+                     __atomic_load_n(&_tail, __ATOMIC_ACQUIRE);
+       }
+
+       MS8607_ring_index capacity(void) const { return _mask + 1; }
+
+       // Samples dropped because the ring was full, wraps around
+       MS8607_ring_index dropped(void) const
+       {
+              return __atomic_load_n(&_dropped, __ATOMIC_RELAXED);
+       }
+
+protected:
+       MS8607_ring_base(struct MS8607_sample_fixed *buffer, MS8607_ring_index capacity)
+           : _buffer(buffer), _mask(capacity - 1), _head(0), _tail(0), _dropped(0)
+       {
+       }
+
+private:
+       struct MS8607_sample_fixed *_buffer;
+       MS8607_ring_index _mask;    // capacity - 1
+       MS8607_ring_index _head;    // Next slot to write, producer owned
+       MS8607_ring_index _tail;    // Next slot to read, consumer owned
+       MS8607_ring_index _dropped; // Producer owned
+};
+
+template <MS8607_ring_index N>
+class MS8607_ring : public MS8607_ring_base
+{
+       static_assert((N != 0) && ((N & (N - 1)) == 0), "N must be a power of 2");
+       static_assert(N <= (MS8607_ring_index)(~(MS8607_ring_index)0) / 2 + 1,
+                     "N must be at most half the index range");
+
+public:
+       MS8607_ring(void) : MS8607_ring_base(_storage, N) {}
+
+private:
+       struct MS8607_sample_fixed _storage[N];
+};
+
 enum i2c_status_code
 {
        i2c_status_ok = 0x00,
@@ -209,16 +447,174 @@ enum i2c_status_code
        i2c_status_err_timeout = 0x02,
 };
 
-class MS8607
+/*
+  Bus policies
+
+  MS8607T is a template over the I2C transport so the bus calls can be
+  inlined and only the transports in use are compiled. A bus policy is a
+  class with:
+
+    typedef ... port_type;           // What begin(port) is given
+    void begin(port_type &port);     // Select the port
+    // Write length bytes to address in one transaction. length 0 probes the
+    // address. Returns an i2c_status_code.
+    uint8_t write(uint8_t address, const uint8_t *data, uint8_t length);
+    // Read up to length bytes from address in one transaction. Returns the
+    // number of bytes received.
+    uint8_t read(uint8_t address, uint8_t *data, uint8_t length);
+    // Free a stuck bus (e.g. clock SCL until SDA is released) and restart
+    // it. Returns false if the policy cannot do it.
+    bool recover(void);
+
+  A policy must be default constructible. MS8607_TwoWireBus is the Arduino
+  Wire policy, and MS8607 is MS8607T<MS8607_TwoWireBus>.
+*/
+#define MS8607_NO_PIN 0xFF
+
+class MS8607_TwoWireBus
+{
+public:
+       typedef TwoWire port_type;
+
+       MS8607_TwoWireBus(void) : _i2cPort(&Wire), _clock(0)
+       {
+#if defined(PIN_WIRE_SDA) && defined(PIN_WIRE_SCL)
+              _sda = PIN_WIRE_SDA;
+              _scl = PIN_WIRE_SCL;
+#else
+              _sda = _scl = MS8607_NO_PIN;
+#endif
+       }
+
+       void begin(TwoWire &wirePort) { _i2cPort = &wirePort; }
+
+       // Pins used by recover() to clock out a stuck slave. Defaults to
+       // PIN_WIRE_SDA/PIN_WIRE_SCL when the core defines them.
+       void set_recovery_pins(uint8_t sda, uint8_t scl)
+       {
+              _sda = sda;
+              _scl = scl;
+       }
+
+       // Set the bus clock, and restore it after recover()
+       void setClock(uint32_t clock)
+       {
+              _clock = clock;
+              _i2cPort->setClock(clock);
+       }
+
+       uint8_t write(uint8_t address, const uint8_t *data, uint8_t length)
+       {
+              _i2cPort->beginTransmission(address);
+              if (length > 0)
+                     _i2cPort->write(data, length);
+              return _i2cPort->endTransmission();
+       }
+
+       uint8_t read(uint8_t address, uint8_t *data, uint8_t length)
+       {
+              uint8_t received = _i2cPort->requestFrom(address, length);
+              for (uint8_t i = 0; i < received; i++)
+                     data[i] = _i2cPort->read();
+              return received;
+       }
+
+       bool recover(void)
+       {
+              if ((_sda == MS8607_NO_PIN) || (_scl == MS8607_NO_PIN))
+                     return false;
+
+              _i2cPort->end();
+
+              // Clock up to 9 bits so a slave holding SDA low finishes its
+              // byte, then send a STOP
+              pinMode(_sda, INPUT_PULLUP);
+              pinMode(_scl, INPUT_PULLUP);
+              for (uint8_t i = 0; (i < 9) && (digitalRead(_sda) == LOW); i++)
+              {
+                     pinMode(_scl, OUTPUT);
+                     digitalWrite(_scl, LOW);
+                     delayMicroseconds(5);
+                     pinMode(_scl, INPUT_PULLUP);
+                     delayMicroseconds(5);
+              }
+              pinMode(_sda, OUTPUT);
+              digitalWrite(_sda, LOW);
+              delayMicroseconds(5);
+              pinMode(_sda, INPUT_PULLUP);
+              delayMicroseconds(5);
+
+              _i2cPort->begin();
+              if (_clock)
+                     _i2cPort->setClock(_clock);
+              return true;
+       }
+
+private:
+       TwoWire *_i2cPort; //The generic connection to user's chosen I2C hardware
+       uint32_t _clock;   //Clock set with setClock(), 0 if never set
+       uint8_t _sda;
+       uint8_t _scl;
+};
+
+template <class Bus>
+class MS8607T
 {
 
 public:
-       MS8607();
+       MS8607T();
 
        /*
    \brief Perform initial configuration. Has to be called once.
+
+   \param[in] Bus::port_type& : Port the bus policy should use (e.g. Wire)
+  */
+       bool begin(typename Bus::port_type &port);
+
+       /*
+   \brief Perform initial configuration on the port the bus policy already
+          uses (Wire by default).
   */
-       bool begin(TwoWire &wirePort = Wire);
+       bool begin(void);
+
+       /*
+   \brief Access the bus policy, e.g. to configure a custom transport
+  */
+       Bus &bus(void) { return _bus; }
+
+       /*
+   \brief Set how failed bus transactions are retried and when the bus is
+          recovered. A transaction is one command, or one command and its
+          answer. The humidity read in no hold mode is not retried, as its
+          NACK means the conversion is not done.
+
+          After recover_after failed transactions in a row the bus policy
+          clears the bus (toggling SCL), both dies are reset and the PROM is
+          read again. The humidity resolution and heater are restored.
+
+   \param[in] MS8607_retry_policy : Retry policy
+  */
+       void set_retry_policy(struct MS8607_retry_policy policy);
+
+       /*
+   \brief Number of bus recoveries since begin()
+  */
+       uint32_t get_recovery_count(void);
+
+#ifdef MS8607_ENABLE_STATS
+       /*
+   \brief Get a snapshot of the bus operation statistics. Only available
+          when the library is built with MS8607_ENABLE_STATS.
+
+   \param[out] MS8607_stats* : Counters and histograms since resetStats()
+  */
+       void getStats(struct MS8607_stats *snapshot);
+
+       /*
+   \brief Clear the bus operation statistics
+  */
+       void resetStats(void);
+#endif
 
        /*
   \brief Check whether MS8607 device is connected
@@ -290,9 +686,15 @@ public:
        /*
    \brief Reads the temperature, pressure and relative humidity value.
 
+          Only the channels requested are acquired, so each application
+          pays only for the conversions it uses. Pressure needs D2, so it
+          always yields temperature too. Pointers of channels that are not
+          requested may be NULL and are left untouched.
+
    \param[out] float* : degC temperature value
    \param[out] float* : mbar pressure value
    \param[out] float* : %RH Relative Humidity value
+   \param[in] uint8_t : MS8607_channel bits to acquire (default all)
 
    \return MS8607_status : status of MS8607
           - MS8607_status_ok : I2C transfer completed successfully
@@ -300,8 +702,244 @@ public:
           - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
           - MS8607_status_crc_error : CRC check error
   */
-       enum MS8607_status read_temperature_pressure_humidity(float *t, float *p,
-                                                             float *h);
+       enum MS8607_status
+       read_temperature_pressure_humidity(float *t, float *p, float *h,
+                                          uint8_t channels = MS8607_channel_all);
+
+       /*
+   \brief Reads the temperature and pressure only (D2 and D1). The humidity
+          die is not accessed.
+
+   \param[out] float* : degC temperature value
+   \param[out] float* : mbar pressure value
+
+   \return MS8607_status : status of MS8607
+          - MS8607_status_ok : I2C transfer completed successfully
+          - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+          - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+  */
+       enum MS8607_status read_pressure_and_temperature(float *t, float *p);
+
+       /*
+   \brief Reads the temperature only, with a single D2 conversion.
+
+   \param[out] float* : degC temperature value
+
+   \return MS8607_status : status of MS8607
+          - MS8607_status_ok : I2C transfer completed successfully
+          - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+          - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+  */
+       enum MS8607_status read_temperature(float *t);
+
+       /*
+   \brief Reads the relative humidity only, with a single RH conversion.
+          The pressure die is not accessed.
+
+   \param[out] float* : %RH Relative Humidity value
+
+   \return MS8607_status : status of MS8607
+          - MS8607_status_ok : I2C transfer completed successfully
+          - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+          - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+          - MS8607_status_crc_error : CRC check error
+  */
+       enum MS8607_status read_humidity(float *h);
+
+       /*
+   \brief Reads the temperature, pressure and relative humidity value in
+          integer units, like read_temperature_pressure_humidity(). The
+          compensation only uses 32-bit integer arithmetic and is bit-exact
+          with the datasheet, so this API needs no floating point at all.
+
+   \param[out] int32_t* : temperature value in 0.01 degC
+   \param[out] int32_t* : pressure value in Pa (0.01 mbar)
+   \param[out] int32_t* : Relative Humidity value in 0.01 %RH
+   \param[in] uint8_t : MS8607_channel bits to acquire (default all)
+
+   \return MS8607_status : status of MS8607
+          - MS8607_status_ok : I2C transfer completed successfully
+          - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+          - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+          - MS8607_status_crc_error : CRC check error
+  */
+       enum MS8607_status
+       read_temperature_pressure_humidity_fixed(int32_t *t, int32_t *p, int32_t *h,
+                                                uint8_t channels = MS8607_channel_all);
+
+       /*
+   \brief Acquire the raw ADC words without compensating them, e.g. for a
+          logger that stores raw records and compensates them offline with
+          the coefficients of get_prom_coefficients(). The conversions are the
+          same as read_temperature_pressure_humidity(): when D2 is skipped
+          (see set_temperature_refresh()) the sample holds the cached D2.
+
+   \param[out] MS8607_raw_sample* : Raw sample
+   \param[in] uint8_t : MS8607_channel bits to acquire (default all)
+
+   \return MS8607_status : status of MS8607
+          - MS8607_status_ok : I2C transfer completed successfully
+          - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+          - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+          - MS8607_status_crc_error : CRC check error
+  */
+       enum MS8607_status read_raw(struct MS8607_raw_sample *raw,
+                                   uint8_t channels = MS8607_channel_all);
+
+       /*
+   \brief Copy the PROM words 0 to 6 read by begin(): the CRC and factory
+          data in word 0, then C1 to C6. Together with the raw samples they
+          give the same results as the driver with MS8607_compensate_*().
+
+   \param[out] uint16_t* : 7 PROM words
+  */
+       void get_prom_coefficients(uint16_t *coeff);
+
+       /******************** Non-blocking acquisition ********************/
+
+       /*
+   \brief Start a non-blocking temperature, pressure and humidity acquisition.
+          The conversions are sequenced by poll(): D2 conversion, D2 read,
+          D1 conversion, D1 read, RH conversion, RH read. In pipelined mode
+          the RH conversion is started together with D2 and read as soon as
+          it is ready. The RH conversion always uses the no hold master
+          command so the bus stays free.
+          Starting a new acquisition abandons any acquisition in progress.
+          Only the channels requested are acquired (pressure implies
+          temperature).
+
+   \param[in] uint8_t : MS8607_channel bits to acquire (default all)
+
+   \return MS8607_status : status of MS8607
+          - MS8607_status_ok : First conversion started
+          - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+          - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+  */
+       enum MS8607_status startMeasurement(uint8_t channels = MS8607_channel_all);
+
+       /*
+   \brief Advance the acquisition started by startMeasurement(). Performs at
+          most one read and one conversion command per call, and only once
+          the current conversion time has elapsed. Call it as often as you like.
+
+   \return MS8607_status : status of the acquisition
+          - MS8607_status_ok : Acquisition in progress, complete or idle
+          - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+          - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+          - MS8607_status_crc_error : CRC check error
+  */
+       enum MS8607_status poll(void);
+
+       /*
+   \brief Poll the acquisition and check whether its result is available
+
+   \return bool : true once getResult() will return a new sample
+  */
+       bool isReady(void);
+
+       /*
+   \brief Get the result of the last non-blocking acquisition. Calls poll().
+          Only the channels that were acquired are copied.
+
+   \param[out] float* : degC temperature value (may be NULL)
+   \param[out] float* : mbar pressure value (may be NULL)
+   \param[out] float* : %RH Relative Humidity value (may be NULL)
+
+   \return MS8607_status : status of MS8607
+          - MS8607_status_ok : Result copied
+          - MS8607_status_busy : Acquisition not started or still in progress
+          - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+          - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+          - MS8607_status_crc_error : CRC check error
+  */
+       enum MS8607_status getResult(float *t, float *p, float *h);
+
+       /*
+   \brief getResult() in integer units
+
+   \param[out] int32_t* : temperature value in 0.01 degC (may be NULL)
+   \param[out] int32_t* : pressure value in Pa (0.01 mbar) (may be NULL)
+   \param[out] int32_t* : Relative Humidity value in 0.01 %RH (may be NULL)
+
+   \return MS8607_status : as getResult()
+  */
+       enum MS8607_status getResult_fixed(int32_t *t, int32_t *p, int32_t *h);
+
+       /*
+   \brief getResult() as raw ADC words, see read_raw()
+
+   \param[out] MS8607_raw_sample* : Raw sample
+
+   \return MS8607_status : as getResult()
+  */
+       enum MS8607_status getResult_raw(struct MS8607_raw_sample *raw);
+
+       /*
+   \brief Current state of the non-blocking acquisition
+  */
+       enum MS8607_acquisition_state getAcquisitionState(void);
+
+       /*
+   \brief Time until the next conversion of the acquisition completes. Use it to
+          sleep between calls to poll().
+
+   \return uint32_t : microseconds, 0 if poll() has work to do now or no
+          acquisition is in progress
+  */
+       uint32_t getMicrosToNextStep(void);
+
+       /*
+   \brief Set how the two dies are sequenced by startMeasurement() and
+          read_temperature_pressure_humidity().
+
+   \param[in] MS8607_acquisition_mode : Acquisition mode
+          - MS8607_acquisition_sequential : D2, D1 then RH, one after the other
+            (default)
+          - MS8607_acquisition_pipelined : RH converts on the humidity die while
+            the pressure die converts D2 and D1. Takes about 36ms instead of
+            52ms at OSR 8192 / 12 bit RH. Always uses the no hold RH command.
+  */
+       void set_acquisition_mode(enum MS8607_acquisition_mode mode);
+
+       /******************** Conversion timing ********************/
+
+       /*
+   \brief Enable or disable adaptive conversion timing.
+          By default the library waits for the worst case conversion time of
+          each die. In adaptive mode it learns how long this device really
+          takes: it reads a little earlier each time until a read comes too
+          early (the pressure die ADC reads 0, the humidity die NACKs a no hold
+          read), then settles on that time plus a safety margin of 1/16 of the
+          worst case. An early humidity read waits out the worst case time; an
+          early pressure read corrupts the conversion, so it is run again with
+          the worst case time. Any error falls back to the worst case and
+          starts learning again.
+          Enabling or disabling restarts learning.
+
+   \param[in] bool : true to learn the conversion times, false to always wait
+          for the worst case conversion time (default)
+  */
+       void set_adaptive_timing(bool enable);
+
+       /*
+   \brief Time waited for a pressure die conversion before reading the ADC.
+          This is the learned time in adaptive mode, the worst case otherwise.
+
+   \param[in] MS8607_pressure_resolution : Resolution
+
+   \return uint32_t : microseconds
+  */
+       uint32_t get_pressure_conversion_time(enum MS8607_pressure_resolution res);
+
+       /*
+   \brief Time waited for a no hold humidity conversion before reading it.
+          This is the learned time in adaptive mode, the worst case otherwise.
+
+   \param[in] MS8607_humidity_resolution : Resolution
+
+   \return uint32_t : microseconds
+  */
+       uint32_t get_humidity_conversion_time(enum MS8607_humidity_resolution res);
 
        /******************** Functions from humidity sensor ********************/
 
@@ -373,15 +1011,151 @@ public:
   */
        void set_pressure_resolution(enum MS8607_pressure_resolution res);
 
+       /*
+   \brief Set how often the temperature (D2) conversion is refreshed.
+          Ambient temperature changes much more slowly than pressure, so the
+          temperature dependent terms (dT, OFF, SENS) can be reused for
+          several pressure samples. Skipping D2 roughly doubles the pressure
+          sample rate. D2 is refreshed as soon as either limit is reached.
+          The default (1, 0) converts D2 before every pressure sample.
+
+   \param[in] uint16_t : Refresh D2 at least every n pressure samples
+          (1 = every sample, 0 = no sample limit)
+   \param[in] uint32_t : Refresh D2 at least every interval ms (0 = no time limit)
+  */
+       void set_temperature_refresh(uint16_t samples, uint32_t interval = 0);
+
+       /*
+   \brief Discard the cached temperature terms so the next pressure sample
+          starts with a D2 conversion.
+  */
+       void invalidate_temperature(void);
+
        float getPressure();    //Returns the latest pressure measurement
        float getTemperature(); //Returns the latest temperature measurement
        float getHumidity();    //Returns the latest humidity measurement
+
+       /*
+   \brief Set the freshness policy of the sample served by getPressure(),
+          getTemperature(), getHumidity() and getSample().
+          With a max age, any combination of getters called within max_age ms
+          of an acquisition is served from that one acquisition.
+          With 0 (default), a new acquisition is made when a value that has
+          already been returned is requested again.
+          Every acquisition (blocking or non-blocking) refreshes the sample.
+
+   \param[in] uint32_t : Max sample age in ms, 0 = each value is used once
+  */
+       void set_max_sample_age(uint32_t max_age);
+
+       /*
+   \brief Get the cached sample, making a new acquisition if it is stale
+          (see set_max_sample_age()). Compare the sequence numbers of two
+          samples to tell whether they came from the same acquisition.
+
+   \param[out] MS8607_sample* : Sample
+
+   \return MS8607_status : status of MS8607
+          - MS8607_status_ok : Sample is valid
+          - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+          - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+          - MS8607_status_crc_error : CRC check error
+  */
+       enum MS8607_status getSample(struct MS8607_sample *sample);
+
+       /*
+   \brief getSample() in integer units
+
+   \param[out] MS8607_sample_fixed* : Sample
+
+   \return MS8607_status : as getSample()
+  */
+       enum MS8607_status getSample_fixed(struct MS8607_sample_fixed *sample);
+
+       /*
+   \brief Sequence number of the sample returned by the last getter call
+  */
+       uint32_t getSampleSequence(void);
+
+       /*
+   \brief Discard the cached sample so the next getter makes an acquisition
+  */
+       void invalidateSample(void);
+
+       /*
+   \brief Set the channels acquired when a getter or getSample() finds the
+          sample stale. A getter always acquires its own channel as well, so
+          with MS8607_channel_humidity getHumidity() costs one RH conversion.
+
+   \param[in] uint8_t : MS8607_channel bits (default MS8607_channel_all)
+  */
+       void set_sample_channels(uint8_t channels);
+
+       /*
+   \brief Push every completed acquisition (blocking or non-blocking) into
+          a ring, compensated, with its timestamp and sequence number. The
+          caller of the acquisition functions is the producer of the ring.
+
+   \param[in] MS8607_ring_base* : Ring, NULL to stop pushing
+  */
+       void set_sample_ring(MS8607_ring_base *ring);
+
+       /*
+   \brief Use a buffer as the PROM coefficient cache. Call before begin().
+          begin() takes the coefficients from the buffer when its magic and
+          CRC are valid and fills it after a full PROM read otherwise. Place
+          the buffer in memory that survives deep sleep to skip the 7 PROM
+          reads on a warm boot.
+
+   \param[in] MS8607_prom_cache* : Cache buffer, NULL to disable
+   \param[in] MS8607_prom_cache_mode : verify (default), trust, or
+          verify_serial which ties the cache to readSerialNumber()
+  */
+       void set_prom_cache(struct MS8607_prom_cache *cache,
+                           enum MS8607_prom_cache_mode mode = MS8607_prom_cache_verify);
+
+       /*
+   \brief Use callbacks as the PROM coefficient cache, e.g. to keep it in
+          EEPROM or flash. Call before begin(). load is tried first, store is
+          called after every full PROM read.
+
+   \param[in] MS8607_prom_cache_load : Load callback, may be NULL
+   \param[in] MS8607_prom_cache_store : Store callback, may be NULL
+   \param[in] void* : Passed unchanged to the callbacks
+   \param[in] MS8607_prom_cache_mode : verify (default) or trust the cache
+  */
+       void set_prom_cache_callbacks(MS8607_prom_cache_load load,
+                                     MS8607_prom_cache_store store,
+                                     void *context,
+                                     enum MS8607_prom_cache_mode mode = MS8607_prom_cache_verify);
+
+       /*
+   \brief Check whether begin() took the coefficients from the cache
+
+   \return bool : true if the full PROM read was skipped
+  */
+       bool prom_cache_hit(void);
+
+       /*
+   \brief Read the 64-bit serial number of the humidity die. The first call
+          reads it from the device, later calls return the cached value until
+          the next begin().
+
+   \param[out] uint64_t* : Serial number (SNB3..SNB0 SNC1 SNC0 SNA1 SNA0)
+
+   \return MS8607_status : status of MS8607
+          - MS8607_status_ok : I2C transfer completed successfully
+          - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+          - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+          - MS8607_status_crc_error : CRC check error
+  */
+       enum MS8607_status readSerialNumber(uint64_t *serial);
        double adjustToSeaLevel(double absolutePressure, double actualAltitude);
        double altitudeChange(double currentPressure, double baselinePressure);
 
 
    // Storage for the 'global' parameters
-   uint16_t eeprom_coeff[COEFFICIENT_NUMBERS + 1]; //Pressure sensor eeprom coefficients
+   uint16_t eeprom_coeff[COEFFICIENT_NUMBERS]; //Pressure sensor eeprom coefficients
    enum MS8607_pressure_resolution psensor_resolution_osr;
 
 
@@ -410,14 +1184,15 @@ private:
        /*
    \brief Check CRC
 
-   \param[in] uint16_t : variable on which to check CRC
+   \param[in] const uint8_t* : data on which to check CRC
+   \param[in] uint8_t : number of data bytes
    \param[in] uint8_t : CRC value
 
    \return MS8607_status : status of MS8607
           - MS8607_status_ok : CRC check is OK
           - MS8607_status_crc_error : CRC check error
   */
-       enum MS8607_status hsensor_crc_check(uint16_t value, uint8_t crc);
+       enum MS8607_status hsensor_crc_check(const uint8_t *data, uint8_t length, uint8_t crc);
 
        /*
    \brief Reads the MS8607 humidity user register.
@@ -431,6 +1206,37 @@ private:
   */
        enum MS8607_status hsensor_read_user_register(uint8_t *value);
 
+       /*
+   \brief Reads the serial number of the humidity die from the device
+
+   \param[out] uint64_t* : Serial number
+
+   \return MS8607_status : status of MS8607
+          - MS8607_status_ok : I2C transfer completed successfully
+          - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+          - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+          - MS8607_status_crc_error : CRC check error
+  */
+       enum MS8607_status hsensor_read_serial_number(uint64_t *serial);
+
+       /*
+   \brief Send a two byte command and read the answer from the humidity die
+
+   \param[in] uint16_t : Command
+   \param[out] uint8_t* : Answer
+   \param[in] uint8_t : Number of bytes to read
+
+   \return MS8607_status : status of MS8607
+          - MS8607_status_ok : I2C transfer completed successfully
+          - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+          - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+  */
+       enum MS8607_status hsensor_read_command(uint16_t command, uint8_t *data,
+                                               uint8_t length);
+
+       uint64_t hsensor_serial_number;
+       bool hsensor_serial_number_valid;
+
        /*
    \brief Writes the MS8607 humidity user register with value
            Will read and keep the unreserved bits of the register
@@ -468,17 +1274,39 @@ private:
        enum MS8607_status hsensor_humidity_conversion_and_read_adc(uint16_t *adc);
 
        /*
-   \brief Reads the relative humidity value.
+   \brief Sends the relative humidity measurement command
 
-   \param[out] float* : %RH Relative Humidity value
+   \param[in] MS8607_i2c_master_mode : Hold or no hold master command
 
    \return MS8607_status : status of MS8607
           - MS8607_status_ok : I2C transfer completed successfully
           - MS8607_status_i2c_transfer_error : Problem with i2c transfer
           - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+  */
+       enum MS8607_status
+       hsensor_start_humidity_conversion(enum MS8607_humidity_i2c_master_mode mode);
+
+       /*
+   \brief Reads and CRC checks the relative humidity ADC value of the last
+          measurement command
+
+   \param[out] uint16_t* : Relative humidity ADC value.
+
+   \return MS8607_status : status of MS8607
+          - MS8607_status_ok : I2C transfer completed successfully
+          - MS8607_status_busy : Conversion not complete (read NACKed)
           - MS8607_status_crc_error : CRC check error
   */
-       enum MS8607_status hsensor_read_relative_humidity(float *humidity);
+       enum MS8607_status hsensor_read_humidity_adc(uint16_t *adc);
+
+       /*
+   \brief Worst case conversion time of a humidity resolution
+
+   \param[in] MS8607_humidity_resolution : Resolution
+
+   \return uint32_t : milliseconds
+  */
+       uint32_t hsensor_max_conversion_time(enum MS8607_humidity_resolution res);
 
        /******************** Functions from Pressure sensor ********************/
 
@@ -527,6 +1355,30 @@ private:
   */
        enum MS8607_status psensor_read_eeprom(void);
 
+       /*
+   \brief Get the EEPROM coefficients from the PROM cache when it is valid,
+          or read them from the device and refresh the cache.
+
+   \return MS8607_status : status of MS8607
+          - MS8607_status_ok : I2C transfer completed successfully
+          - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+          - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+          - MS8607_status_crc_error : CRC check error on the coefficients
+  */
+       enum MS8607_status psensor_load_eeprom(void);
+
+       // Copy a valid cache into eeprom_coeff. Returns false if it is not
+       // usable, or if it belongs to another serial number in verify_serial mode.
+       bool prom_cache_restore(const struct MS8607_prom_cache *cache,
+                               uint64_t serial);
+
+       struct MS8607_prom_cache *prom_cache;
+       MS8607_prom_cache_load prom_cache_load;
+       MS8607_prom_cache_store prom_cache_store;
+       void *prom_cache_context;
+       enum MS8607_prom_cache_mode prom_cache_mode;
+       bool prom_cache_used;
+
        /*
    \brief CRC check
 
@@ -535,22 +1387,21 @@ private:
 
    \return bool : TRUE if CRC is OK, FALSE if KO
   */
-       bool psensor_crc_check(uint16_t *n_prom, uint8_t crc);
+       bool psensor_crc_check(const uint16_t *n_prom, uint8_t crc);
 
        /*
-   \brief Compute temperature and pressure
+   \brief Convert D1 and, when needed, D2
 
-   \param[out] float* : Celsius Degree temperature value
-   \param[out] float* : mbar pressure value
+   \param[in] uint8_t : MS8607_channel bits, temperature and/or pressure
+   \param[out] MS8607_raw_sample* : D1 and D2 words
 
    \return MS8607_status : status of MS8607
           - MS8607_status_ok : I2C transfer completed successfully
           - MS8607_status_i2c_transfer_error : Problem with i2c transfer
           - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
-          - MS8607_status_crc_error : CRC check error on the coefficients
   */
-       enum MS8607_status psensor_read_pressure_and_temperature(float *temperature,
-                                                                float *pressure);
+       enum MS8607_status psensor_read_raw(uint8_t channels,
+                                           struct MS8607_raw_sample *raw);
 
        /*
    \brief Triggers conversion and read ADC value
@@ -567,16 +1418,243 @@ private:
        enum MS8607_status psensor_conversion_and_read_adc(uint8_t cmd,
                                                           uint32_t *adc);
 
+       /*
+   \brief Sends a conversion command
+
+   \param[in] uint8_t : Command used for conversion (will determine
+    Temperature vs Pressure and osr)
+
+   \return MS8607_status : status of MS8607
+          - MS8607_status_ok : I2C transfer completed successfully
+          - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+          - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+  */
+       enum MS8607_status psensor_start_conversion(uint8_t cmd);
+
+       /*
+   \brief Reads the ADC value of the last conversion
+
+   \param[out] uint32_t* : ADC value.
+
+   \return MS8607_status : status of MS8607
+          - MS8607_status_ok : I2C transfer completed successfully
+          - MS8607_status_busy : Conversion not complete (ADC read 0)
+          - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+          - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+  */
+       enum MS8607_status psensor_read_adc(uint32_t *adc);
+
+       /*
+   \brief Store a D2 ADC value as the cached temperature, see
+          set_temperature_refresh()
+
+   \param[in] uint32_t : D2 temperature ADC value
+
+   \return MS8607_status : status of MS8607
+          - MS8607_status_ok : Value stored
+          - MS8607_status_i2c_transfer_error : ADC value is 0
+  */
+       enum MS8607_status psensor_store_temperature(uint32_t adc_temperature);
+
+       /*
+   \brief Check a D1 ADC value and count it against the cached temperature
+
+   \param[in] uint32_t : D1 pressure ADC value
+
+   \return MS8607_status : status of MS8607
+          - MS8607_status_ok : Value accepted
+          - MS8607_status_i2c_transfer_error : ADC value is 0
+  */
+       enum MS8607_status psensor_store_pressure(uint32_t adc_pressure);
+
+       /*
+   \brief Compensate a raw sample. The temperature terms of the last D2
+          value are cached, so samples sharing a D2 only cost the pressure
+          step.
+
+   \param[in] const MS8607_raw_sample* : Raw sample
+   \param[out] MS8607_sample_fixed* : Temperature, pressure and humidity of
+          the channels of the raw sample, 0 for the others
+  */
+       void compensate_raw(const struct MS8607_raw_sample *raw,
+                           struct MS8607_sample_fixed *values);
+
+       /*
+   \brief Check whether the next pressure sample needs a new D2 conversion
+
+   \return bool : true if D2 must be converted
+  */
+       bool psensor_temperature_refresh_due(void);
+
+       /******************** Non-blocking acquisition ********************/
+
+       // Start the RH conversion of the current acquisition
+       enum MS8607_status acquisition_start_humidity(void);
+
+       // Start a D2 (temperature_conversion) or D1 (pressure_conversion) conversion
+       enum MS8607_status
+       acquisition_start_pressure(enum MS8607_acquisition_state conversion);
+
+       // Advance the pressure die and humidity die lanes of the acquisition
+       enum MS8607_status acquisition_poll_psensor(void);
+       enum MS8607_status acquisition_poll_hsensor(void);
+
+       // Move the acquisition to the error state and return status
+       enum MS8607_status acquisition_abort(enum MS8607_status status);
+
+       // Block until the current acquisition completes or fails
+       enum MS8607_status acquisition_wait_complete(void);
+
+       /******************** Conversion timing ********************/
+
+       struct conversion_timing
+       {
+              uint32_t learned; // us to wait before reading
+              bool settled;     // An early read has bounded the conversion time
+       };
+
+       void reset_conversion_timing(void);
+       uint32_t conversion_timing_wait(struct conversion_timing *timing,
+                                       uint32_t worst);
+       void conversion_timing_update(struct conversion_timing *timing,
+                                     uint32_t waited, enum MS8607_status status,
+                                     uint32_t worst);
+       void wait_until(uint32_t start, uint32_t us);
+
        uint32_t hsensor_conversion_time;
+       enum MS8607_humidity_resolution hsensor_resolution;
        bool hsensor_heater_on;
        uint32_t psensor_conversion_time[6];
 
-       TwoWire *_i2cPort; //The generic connection to user's chosen I2C hardware
-       float globalPressure;
-       boolean pressureHasBeenRead = true;
-       float globalTemperature;
-       boolean temperatureHasBeenRead = true;
-       float globalHumidity;
-       boolean humidityHasBeenRead = true;
+       // Adaptive conversion timing, indexed by resolution
+       bool adaptive_timing;
+       struct conversion_timing psensor_timing[6];
+       struct conversion_timing hsensor_timing[4];
+
+       // Cached D2, see set_temperature_refresh()
+       bool psensor_temperature_valid;
+       uint32_t psensor_adc_temperature;
+       uint16_t psensor_temperature_samples; // Pressure samples since the last D2
+       uint32_t psensor_temperature_time;    // millis() of the last D2
+       uint16_t psensor_temperature_refresh_samples;
+       uint32_t psensor_temperature_refresh_interval;
+
+       // Temperature terms of the D2 value psensor_terms_adc, 0 = none
+       struct MS8607_temperature_terms psensor_terms;
+       uint32_t psensor_terms_adc;
+
+       enum MS8607_acquisition_mode acquisition_mode;
+       uint8_t acquisition_channels; // MS8607_channel bits of the current acquisition
+       enum MS8607_acquisition_state acquisition_state; // idle, busy (temperature_conversion), complete or error
+       enum MS8607_status acquisition_status;
+       enum MS8607_acquisition_state acquisition_psensor_state;
+       uint32_t acquisition_psensor_start; // micros() when the current D1/D2 conversion was started
+       uint32_t acquisition_psensor_wait;  // us to wait for the current D1/D2 conversion
+       bool acquisition_psensor_restarted; // The current conversion has been restarted once
+       enum MS8607_acquisition_state acquisition_hsensor_state;
+       uint32_t acquisition_hsensor_start; // micros() when the RH conversion was started
+       uint32_t acquisition_hsensor_wait;  // us to wait for the RH conversion
+       struct MS8607_raw_sample acquisition_raw;
+
+       Bus _bus; //The I2C transport policy
+
+       struct MS8607_retry_policy retry_policy;
+       uint8_t bus_failures; // Failed transactions in a row
+       bool bus_recovering;
+       uint32_t bus_recoveries;
+
+       /*
+   \brief Write tx, then read rx if rx_length is not 0, with the retry
+          policy. The read is skipped if the write fails.
+
+   \return MS8607_status : status of MS8607
+          - MS8607_status_ok : I2C transfer completed successfully
+          - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+          - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+  */
+       enum MS8607_status bus_transfer(enum MS8607_operation operation,
+                                       uint8_t address, const uint8_t *tx,
+                                       uint8_t tx_length, uint8_t *rx,
+                                       uint8_t rx_length);
+
+       // Free the bus, reset both dies and reload the PROM
+       void bus_recover(void);
+
+       // Bus access, counting the bytes of each operation when stats are enabled
+       uint8_t bus_write(enum MS8607_operation operation, uint8_t address,
+                         const uint8_t *data, uint8_t length)
+       {
+#ifdef MS8607_ENABLE_STATS
+              stats.operation[operation].bytes += length;
+#else
+              (void)operation;
+#endif
+              return _bus.write(address, data, length);
+       }
+
+       uint8_t bus_read(enum MS8607_operation operation, uint8_t address,
+                        uint8_t *data, uint8_t length)
+       {
+              uint8_t received = _bus.read(address, data, length);
+#ifdef MS8607_ENABLE_STATS
+              stats.operation[operation].bytes += received;
+#else
+              (void)operation;
+#endif
+              return received;
+       }
+
+#ifdef MS8607_ENABLE_STATS
+       struct MS8607_stats stats;
+
+       uint32_t stats_start(void) { return micros(); }
+
+       // Count a completed operation that started at start (micros())
+       enum MS8607_status stats_record(enum MS8607_operation operation,
+                                       enum MS8607_status status, uint32_t start);
+#else
+       uint32_t stats_start(void) { return 0; }
+
+       enum MS8607_status stats_record(enum MS8607_operation operation,
+                                       enum MS8607_status status, uint32_t start)
+       {
+              (void)operation;
+              (void)start;
+              return status;
+       }
+#endif
+
+       // Cached sample served by the getters, compensated on first use
+       struct MS8607_sample_fixed sample;
+       struct MS8607_raw_sample sample_raw;
+       bool sample_compensated;
+       uint32_t sample_max_age;
+       uint8_t sample_consumed; // MS8607_channel bits already returned
+       uint8_t sample_channels; // MS8607_channel bits acquired by the getters
+       MS8607_ring_base *sample_ring;
+
+       // Store a completed acquisition as the new sample
+       void sample_store(const struct MS8607_raw_sample *raw);
+
+       // Compensate the sample if it has not been yet
+       void sample_compensate(void);
+
+       // Copy the channels held by the sample to the non-NULL pointers
+       void sample_copy(float *t, float *p, float *h);
+       void sample_copy_fixed(int32_t *t, int32_t *p, int32_t *h);
+
+       // Make a new acquisition if the channel of the sample is stale
+       enum MS8607_status sample_refresh(uint8_t channel);
 };
+
+#include "SparkFun_PHT_MS8607_Arduino_Library_impl.h"
+
+// The Wire instantiation is compiled once, in SparkFun_PHT_MS8607_Arduino_Library.cpp
+extern template class MS8607T<MS8607_TwoWireBus>;
+
+// A class rather than a typedef, so that "class MS8607;" still declares it
+class MS8607 : public MS8607T<MS8607_TwoWireBus>
+{
+};
+
 #endif
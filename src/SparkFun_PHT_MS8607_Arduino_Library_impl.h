@@ -0,0 +1,2462 @@
+/*
+  This is a library written for the MS8607. Originally written by TEConnectivity
+  with an MIT license. Library updated and brought to fit Arduino Library standards
+  by PaulZC, October 30th, 2019.
+
+  Member functions of the MS8607T<Bus> template. This file is included by
+  SparkFun_PHT_MS8607_Arduino_Library.h, include that header instead.
+
+  MIT License. See SparkFun_PHT_MS8607_Arduino_Library.h.
+*/
+
+#ifndef MS8607_ARDUINO_LIBRARY_IMPL_H
+#define MS8607_ARDUINO_LIBRARY_IMPL_H
+
+#include "SparkFun_PHT_MS8607_Arduino_Library.h"
+
+template <class Bus>
+MS8607T<Bus>::MS8607T(void)
+    : psensor_conversion_time{
+          PSENSOR_CONVERSION_TIME_OSR_256, PSENSOR_CONVERSION_TIME_OSR_512,
+          PSENSOR_CONVERSION_TIME_OSR_1024, PSENSOR_CONVERSION_TIME_OSR_2048,
+          PSENSOR_CONVERSION_TIME_OSR_4096, PSENSOR_CONVERSION_TIME_OSR_8192}
+{
+
+  hsensor_conversion_time = HSENSOR_CONVERSION_TIME_12b;
+  hsensor_i2c_master_mode = MS8607_i2c_no_hold;
+  hsensor_heater_on = false;
+  hsensor_resolution = MS8607_humidity_resolution_12b;
+  adaptive_timing = false;
+  reset_conversion_timing();
+  psensor_temperature_valid = false;
+  psensor_temperature_refresh_samples = 1;
+  psensor_temperature_refresh_interval = 0;
+  psensor_terms_adc = 0;
+  acquisition_mode = MS8607_acquisition_sequential;
+  acquisition_state = MS8607_acquisition_idle;
+  acquisition_status = MS8607_status_ok;
+  acquisition_psensor_state = MS8607_acquisition_idle;
+  acquisition_hsensor_state = MS8607_acquisition_idle;
+  sample.sequence = 0;
+  sample.channels = 0;
+  sample_compensated = true;
+  sample_max_age = 0;
+  sample_consumed = 0;
+  sample_channels = MS8607_channel_all;
+  sample_ring = NULL;
+  prom_cache = NULL;
+  prom_cache_load = NULL;
+  prom_cache_store = NULL;
+  prom_cache_context = NULL;
+  prom_cache_mode = MS8607_prom_cache_verify;
+  prom_cache_used = false;
+  hsensor_serial_number = 0;
+  hsensor_serial_number_valid = false;
+  retry_policy.retries = 0;
+  retry_policy.backoff_us = 0;
+  retry_policy.deadline_us = 0;
+  retry_policy.recover_after = 0;
+  bus_failures = 0;
+  bus_recovering = false;
+  bus_recoveries = 0;
+#ifdef MS8607_ENABLE_STATS
+  resetStats();
+#endif
+}
+
+/*
+  \brief Perform initial configuration. Has to be called once.
+*/
+template <class Bus>
+bool MS8607T<Bus>::begin(typename Bus::port_type &port)
+{
+  _bus.begin(port); //Grab which port the user wants us to use
+  return begin();
+}
+
+/*
+  \brief Perform initial configuration on the bus as it is configured now.
+*/
+template <class Bus>
+bool MS8607T<Bus>::begin(void)
+{
+  hsensor_serial_number_valid = false; //The port may hold a different device now
+  bus_failures = 0;
+  bus_recoveries = 0;
+
+  //Check connection
+  if (isConnected() == false)
+    return (false);
+
+  //Get EEPROM coefficients, from the PROM cache if there is a valid one
+  enum MS8607_status status = psensor_load_eeprom();
+  if (status != MS8607_status_ok)
+    return (false);
+
+  //Set resolution to the highest level (17 ms per reading)
+  psensor_resolution_osr = MS8607_pressure_resolution_osr_8192;
+
+  return (true);
+}
+
+/*
+  \brief Check whether MS8607 device is connected
+
+  \return bool : status of MS8607
+       - true : Device is present
+       - false : Device is not acknowledging I2C address
+*/
+template <class Bus>
+bool MS8607T<Bus>::isConnected(void)
+{
+  return (hsensor_is_connected() && psensor_is_connected());
+}
+
+/*
+  \brief Reset the MS8607 device
+
+  \return MS8607_status : status of MS8607
+       - MS8607_status_ok : I2C transfer completed successfully
+       - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+       - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::reset(void)
+{
+  enum MS8607_status status = hsensor_reset();
+  if (status != MS8607_status_ok)
+    return status;
+
+  status = psensor_reset();
+  return status;
+}
+
+/*
+  \brief Set Humidity sensor ADC resolution.
+
+  \param[in] MS8607_i2c_master_mode : I2C mode
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok
+*/
+template <class Bus>
+void MS8607T<Bus>::set_humidity_i2c_master_mode(
+    enum MS8607_humidity_i2c_master_mode mode)
+{
+  hsensor_i2c_master_mode = mode;
+}
+
+/*
+  \brief Provide battery status
+
+  \param[out] MS8607_battery_status* : Battery status
+                       - MS8607_battery_ok,
+                       - MS8607_battery_low
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::get_battery_status(enum MS8607_battery_status *bat)
+{
+  uint8_t reg_value;
+
+  enum MS8607_status status = hsensor_read_user_register(&reg_value);
+  if (status != MS8607_status_ok)
+    return status;
+
+  if (reg_value & HSENSOR_USER_REG_END_OF_BATTERY_VDD_BELOW_2_25V)
+    *bat = MS8607_battery_low;
+  else
+    *bat = MS8607_battery_ok;
+
+  return status;
+}
+
+/*
+  \brief Enable heater
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::enable_heater(void)
+{
+  uint8_t reg_value;
+
+  enum MS8607_status status = hsensor_read_user_register(&reg_value);
+  if (status != MS8607_status_ok)
+    return status;
+
+  // Clear the resolution bits
+  reg_value |= HSENSOR_USER_REG_ONCHIP_HEATER_ENABLE;
+  hsensor_heater_on = true;
+
+  status = hsensor_write_user_register(reg_value);
+
+  return status;
+}
+
+/*
+  \brief Disable heater
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::disable_heater(void)
+{
+  uint8_t reg_value;
+
+  enum MS8607_status status = hsensor_read_user_register(&reg_value);
+  if (status != MS8607_status_ok)
+    return status;
+
+  // Clear the resolution bits
+  reg_value &= ~HSENSOR_USER_REG_ONCHIP_HEATER_ENABLE;
+  hsensor_heater_on = false;
+
+  status = hsensor_write_user_register(reg_value);
+
+  return status;
+}
+
+/*
+  \brief Get heater status
+
+  \param[in] MS8607_heater_status* : Return heater status (above or below 2.5V)
+ 	                    - MS8607_heater_off,
+                       - MS8607_heater_on
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+*/
+template <class Bus>
+enum MS8607_status
+MS8607T<Bus>::get_heater_status(enum MS8607_heater_status *heater)
+{
+  uint8_t reg_value;
+
+  enum MS8607_status status = hsensor_read_user_register(&reg_value);
+  if (status != MS8607_status_ok)
+    return status;
+
+  // Get the heater enable bit in reg_value
+  if (reg_value & HSENSOR_USER_REG_ONCHIP_HEATER_ENABLE)
+    *heater = MS8607_heater_on;
+  else
+    *heater = MS8607_heater_off;
+
+  return status;
+}
+
+/*
+  \brief Reads the temperature, pressure and relative humidity value.
+
+  \param[out] float* : degC temperature value
+  \param[out] float* : mbar pressure value
+  \param[out] float* : %RH Relative Humidity value
+  \param[in] uint8_t : MS8607_channel bits to acquire
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+        - MS8607_status_crc_error : CRC check error
+*/
+template <class Bus>
+enum MS8607_status
+MS8607T<Bus>::read_temperature_pressure_humidity(float *t, float *p, float *h,
+                                                 uint8_t channels)
+{
+  int32_t temperature = 0, pressure = 0, humidity = 0;
+
+  enum MS8607_status status = read_temperature_pressure_humidity_fixed(
+      &temperature, &pressure, &humidity, channels);
+  if (status != MS8607_status_ok)
+    return status;
+
+  sample_copy(t, p, h);
+
+  return status;
+}
+
+/*
+  \brief Reads the temperature, pressure and relative humidity value in
+         integer units.
+
+  \param[out] int32_t* : temperature value in 0.01 degC
+  \param[out] int32_t* : pressure value in Pa (0.01 mbar)
+  \param[out] int32_t* : Relative Humidity value in 0.01 %RH
+  \param[in] uint8_t : MS8607_channel bits to acquire
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+        - MS8607_status_crc_error : CRC check error
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::read_temperature_pressure_humidity_fixed(
+    int32_t *t, int32_t *p, int32_t *h, uint8_t channels)
+{
+  struct MS8607_raw_sample raw;
+
+  enum MS8607_status status = read_raw(&raw, channels);
+  if (status != MS8607_status_ok)
+    return status;
+
+  sample_copy_fixed(t, p, h);
+
+  return status;
+}
+
+/*
+  \brief Acquire the raw ADC words without compensating them.
+
+  \param[out] MS8607_raw_sample* : Raw sample
+  \param[in] uint8_t : MS8607_channel bits to acquire
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+        - MS8607_status_crc_error : CRC check error
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::read_raw(struct MS8607_raw_sample *raw,
+                                          uint8_t channels)
+{
+  enum MS8607_status status = MS8607_status_ok;
+
+  if (acquisition_mode == MS8607_acquisition_pipelined)
+  {
+    status = startMeasurement(channels);
+    if (status == MS8607_status_ok)
+      status = acquisition_wait_complete();
+    if (status != MS8607_status_ok)
+      return status;
+
+    return getResult_raw(raw);
+  }
+
+  // Pressure needs the temperature terms, so it always yields temperature
+  if (channels & MS8607_channel_pressure)
+    channels |= MS8607_channel_temperature;
+  raw->adc_pressure = 0;
+  raw->adc_temperature = 0;
+  raw->adc_humidity = 0;
+  raw->channels = channels & MS8607_channel_all;
+
+  if (channels & MS8607_channel_temperature)
+  {
+    status = psensor_read_raw(channels, raw);
+    if (status != MS8607_status_ok)
+      return status;
+  }
+
+  if (channels & MS8607_channel_humidity)
+  {
+    status = hsensor_humidity_conversion_and_read_adc(&raw->adc_humidity);
+    if (status != MS8607_status_ok)
+      return status;
+  }
+
+  sample_store(raw);
+
+  return status;
+}
+
+/*
+  \brief Copy the PROM words 0 to 6 read by begin()
+
+  \param[out] uint16_t* : 7 PROM words
+*/
+template <class Bus>
+void MS8607T<Bus>::get_prom_coefficients(uint16_t *coeff)
+{
+  for (uint8_t i = 0; i < COEFFICIENT_NUMBERS; i++)
+    coeff[i] = eeprom_coeff[i];
+}
+
+/*
+  \brief Reads the temperature and pressure only. The humidity die is not
+         accessed.
+
+  \param[out] float* : degC temperature value
+  \param[out] float* : mbar pressure value
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::read_pressure_and_temperature(float *t, float *p)
+{
+  return read_temperature_pressure_humidity(
+      t, p, NULL, MS8607_channel_pressure | MS8607_channel_temperature);
+}
+
+/*
+  \brief Reads the temperature only, with a single D2 conversion.
+
+  \param[out] float* : degC temperature value
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::read_temperature(float *t)
+{
+  return read_temperature_pressure_humidity(t, NULL, NULL,
+                                            MS8607_channel_temperature);
+}
+
+/*
+  \brief Reads the relative humidity only, with a single RH conversion.
+
+  \param[out] float* : %RH Relative Humidity value
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+        - MS8607_status_crc_error : CRC check error
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::read_humidity(float *h)
+{
+  return read_temperature_pressure_humidity(NULL, NULL, h,
+                                            MS8607_channel_humidity);
+}
+
+/******************** Non-blocking acquisition ********************/
+
+/*
+  \brief Start a non-blocking temperature, pressure and humidity acquisition.
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : First conversion started
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::startMeasurement(uint8_t channels)
+{
+  enum MS8607_status status;
+
+  if (channels & MS8607_channel_pressure)
+    channels |= MS8607_channel_temperature;
+
+  acquisition_channels = channels & MS8607_channel_all;
+  acquisition_raw.adc_pressure = 0;
+  acquisition_raw.adc_temperature = 0;
+  acquisition_raw.adc_humidity = 0;
+  acquisition_raw.channels = acquisition_channels;
+  acquisition_state = MS8607_acquisition_temperature_conversion;
+  acquisition_status = MS8607_status_ok;
+  acquisition_psensor_state = MS8607_acquisition_complete;
+  acquisition_hsensor_state = MS8607_acquisition_complete;
+
+  if (channels & MS8607_channel_humidity)
+    acquisition_hsensor_state = MS8607_acquisition_idle;
+
+  // In pipelined mode the humidity die converts while the pressure die does
+  if ((acquisition_mode == MS8607_acquisition_pipelined) ||
+      !(channels & MS8607_channel_temperature))
+  {
+    if (acquisition_hsensor_state == MS8607_acquisition_idle)
+    {
+      status = acquisition_start_humidity();
+      if (status != MS8607_status_ok)
+        return acquisition_abort(status);
+    }
+  }
+
+  if (channels & MS8607_channel_temperature)
+  {
+    // Skip D2 when the cached temperature terms can be reused
+    if (!(channels & MS8607_channel_pressure) || psensor_temperature_refresh_due())
+      status = acquisition_start_pressure(MS8607_acquisition_temperature_conversion);
+    else
+      status = acquisition_start_pressure(MS8607_acquisition_pressure_conversion);
+    if (status != MS8607_status_ok)
+      return acquisition_abort(status);
+  }
+
+  return poll();
+}
+
+/*
+  \brief Advance the acquisition started by startMeasurement().
+
+  \return MS8607_status : status of the acquisition
+        - MS8607_status_ok : Acquisition in progress, complete or idle
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+        - MS8607_status_crc_error : CRC check error
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::poll(void)
+{
+  enum MS8607_status status;
+
+  if (acquisition_state != MS8607_acquisition_temperature_conversion)
+    return acquisition_status;
+
+  status = acquisition_poll_psensor();
+  if (status != MS8607_status_ok)
+    return acquisition_abort(status);
+
+  status = acquisition_poll_hsensor();
+  if (status != MS8607_status_ok)
+    return acquisition_abort(status);
+
+  if ((acquisition_psensor_state != MS8607_acquisition_complete) ||
+      (acquisition_hsensor_state != MS8607_acquisition_complete))
+    return MS8607_status_ok;
+
+  acquisition_state = MS8607_acquisition_complete;
+  sample_store(&acquisition_raw);
+
+  return MS8607_status_ok;
+}
+
+/*
+  \brief Poll the acquisition and check whether its result is available
+
+  \return bool : true once getResult() will return a new sample
+*/
+template <class Bus>
+bool MS8607T<Bus>::isReady(void)
+{
+  poll();
+  return (acquisition_state == MS8607_acquisition_complete);
+}
+
+/*
+  \brief Get the result of the last non-blocking acquisition. Calls poll().
+
+  \param[out] float* : degC temperature value (may be NULL)
+  \param[out] float* : mbar pressure value (may be NULL)
+  \param[out] float* : %RH Relative Humidity value (may be NULL)
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : Result copied
+        - MS8607_status_busy : Acquisition not started or still in progress
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+        - MS8607_status_crc_error : CRC check error
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::getResult(float *t, float *p, float *h)
+{
+  int32_t temperature = 0, pressure = 0, humidity = 0;
+
+  enum MS8607_status status = getResult_fixed(&temperature, &pressure, &humidity);
+  if (status != MS8607_status_ok)
+    return status;
+
+  if ((t != NULL) && (acquisition_channels & MS8607_channel_temperature))
+    *t = (float)temperature / 100;
+  if ((p != NULL) && (acquisition_channels & MS8607_channel_pressure))
+    *p = (float)pressure / 100;
+  if ((h != NULL) && (acquisition_channels & MS8607_channel_humidity))
+    *h = (float)humidity / 100;
+
+  return MS8607_status_ok;
+}
+
+/*
+  \brief getResult() in integer units
+
+  \param[out] int32_t* : temperature value in 0.01 degC (may be NULL)
+  \param[out] int32_t* : pressure value in Pa (0.01 mbar) (may be NULL)
+  \param[out] int32_t* : Relative Humidity value in 0.01 %RH (may be NULL)
+
+  \return MS8607_status : as getResult()
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::getResult_fixed(int32_t *t, int32_t *p, int32_t *h)
+{
+  struct MS8607_raw_sample raw;
+  struct MS8607_sample_fixed values;
+
+  enum MS8607_status status = getResult_raw(&raw);
+  if (status != MS8607_status_ok)
+    return status;
+
+  compensate_raw(&raw, &values);
+
+  if ((t != NULL) && (raw.channels & MS8607_channel_temperature))
+    *t = values.temperature;
+  if ((p != NULL) && (raw.channels & MS8607_channel_pressure))
+    *p = values.pressure;
+  if ((h != NULL) && (raw.channels & MS8607_channel_humidity))
+    *h = values.humidity;
+
+  return MS8607_status_ok;
+}
+
+/*
+  \brief getResult() as raw ADC words
+
+  \param[out] MS8607_raw_sample* : Raw sample
+
+  \return MS8607_status : as getResult()
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::getResult_raw(struct MS8607_raw_sample *raw)
+{
+  enum MS8607_status status = poll();
+  if (status != MS8607_status_ok)
+    return status;
+
+  if (acquisition_state != MS8607_acquisition_complete)
+    return MS8607_status_busy;
+
+  *raw = acquisition_raw;
+
+  return MS8607_status_ok;
+}
+
+/*
+  \brief Current state of the non-blocking acquisition
+*/
+template <class Bus>
+enum MS8607_acquisition_state MS8607T<Bus>::getAcquisitionState(void)
+{
+  if (acquisition_state != MS8607_acquisition_temperature_conversion)
+    return acquisition_state;
+
+  // Report the pressure die while it is busy, then the humidity die
+  if ((acquisition_psensor_state == MS8607_acquisition_temperature_conversion) ||
+      (acquisition_psensor_state == MS8607_acquisition_pressure_conversion))
+    return acquisition_psensor_state;
+
+  return MS8607_acquisition_humidity_conversion;
+}
+
+/*
+  \brief Time until the next conversion of the acquisition completes.
+
+  \return uint32_t : microseconds, 0 if poll() has work to do now or no
+        acquisition is in progress
+*/
+template <class Bus>
+uint32_t MS8607T<Bus>::getMicrosToNextStep(void)
+{
+  uint32_t remaining = 0xFFFFFFFF;
+  uint32_t elapsed;
+
+  if (acquisition_state != MS8607_acquisition_temperature_conversion)
+    return 0;
+
+  if ((acquisition_psensor_state == MS8607_acquisition_temperature_conversion) ||
+      (acquisition_psensor_state == MS8607_acquisition_pressure_conversion))
+  {
+    elapsed = micros() - acquisition_psensor_start;
+    if (elapsed >= acquisition_psensor_wait)
+      return 0;
+    remaining = acquisition_psensor_wait - elapsed;
+  }
+
+  if (acquisition_hsensor_state == MS8607_acquisition_humidity_conversion)
+  {
+    elapsed = micros() - acquisition_hsensor_start;
+    if (elapsed >= acquisition_hsensor_wait)
+      return 0;
+    if (acquisition_hsensor_wait - elapsed < remaining)
+      remaining = acquisition_hsensor_wait - elapsed;
+  }
+
+  return (remaining == 0xFFFFFFFF) ? 0 : remaining;
+}
+
+/*
+  \brief Set how the two dies are sequenced by startMeasurement() and
+         read_temperature_pressure_humidity().
+
+  \param[in] MS8607_acquisition_mode : Acquisition mode
+*/
+template <class Bus>
+void MS8607T<Bus>::set_acquisition_mode(enum MS8607_acquisition_mode mode)
+{
+  acquisition_mode = mode;
+}
+
+template <class Bus>
+enum MS8607_status
+MS8607T<Bus>::acquisition_start_pressure(enum MS8607_acquisition_state conversion)
+{
+  uint8_t cmd;
+
+  cmd = psensor_resolution_osr * 2;
+  if (conversion == MS8607_acquisition_temperature_conversion)
+    cmd |= PSENSOR_START_TEMPERATURE_ADC_CONVERSION;
+  else
+    cmd |= PSENSOR_START_PRESSURE_ADC_CONVERSION;
+
+  uint32_t stats = stats_start();
+  enum MS8607_status status = psensor_start_conversion(cmd);
+  if (status != MS8607_status_ok)
+    return stats_record(MS8607_operation_pressure_adc, status, stats);
+
+  acquisition_psensor_start = micros();
+  acquisition_psensor_wait = conversion_timing_wait(
+      &psensor_timing[psensor_resolution_osr],
+      psensor_conversion_time[psensor_resolution_osr] * 1000UL);
+  acquisition_psensor_state = conversion;
+  acquisition_psensor_restarted = false;
+
+  return MS8607_status_ok;
+}
+
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::acquisition_poll_psensor(void)
+{
+  enum MS8607_status status;
+  uint32_t adc;
+  uint32_t worst = psensor_conversion_time[psensor_resolution_osr] * 1000UL;
+  struct conversion_timing *timing = &psensor_timing[psensor_resolution_osr];
+
+  if (((acquisition_psensor_state != MS8607_acquisition_temperature_conversion) &&
+       (acquisition_psensor_state != MS8607_acquisition_pressure_conversion)) ||
+      ((uint32_t)(micros() - acquisition_psensor_start) < acquisition_psensor_wait))
+    return MS8607_status_ok;
+
+  status = psensor_read_adc(&adc);
+  conversion_timing_update(timing, acquisition_psensor_wait, status, worst);
+
+  if (status == MS8607_status_busy)
+  {
+    // A read before the end of the conversion corrupts it, so whether it came
+    // too early or the conversion was lost, run it once more
+    if (acquisition_psensor_wait >= worst)
+      conversion_timing_update(timing, worst, MS8607_status_i2c_transfer_error, worst);
+    if (acquisition_psensor_restarted)
+      return stats_record(MS8607_operation_pressure_adc,
+                          MS8607_status_i2c_transfer_error,
+                          acquisition_psensor_start);
+
+    status = acquisition_start_pressure(acquisition_psensor_state);
+    acquisition_psensor_wait = worst;
+    acquisition_psensor_restarted = true;
+    return status;
+  }
+  stats_record(MS8607_operation_pressure_adc, status, acquisition_psensor_start);
+  if (status != MS8607_status_ok)
+    return status;
+
+  if (acquisition_psensor_state == MS8607_acquisition_temperature_conversion)
+  {
+    status = psensor_store_temperature(adc);
+    if (status != MS8607_status_ok)
+      return status;
+    acquisition_raw.adc_temperature = adc;
+
+    // D2 done, now D1
+    if (acquisition_channels & MS8607_channel_pressure)
+      return acquisition_start_pressure(MS8607_acquisition_pressure_conversion);
+  }
+  else
+  {
+    status = psensor_store_pressure(adc);
+    if (status != MS8607_status_ok)
+      return status;
+    acquisition_raw.adc_temperature = psensor_adc_temperature;
+    acquisition_raw.adc_pressure = adc;
+  }
+
+  acquisition_psensor_state = MS8607_acquisition_complete;
+
+  // In sequential mode the humidity die starts once the pressure die is done
+  if (acquisition_hsensor_state == MS8607_acquisition_idle)
+    return acquisition_start_humidity();
+
+  return MS8607_status_ok;
+}
+
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::acquisition_start_humidity(void)
+{
+  uint32_t stats = stats_start();
+  enum MS8607_status status = hsensor_start_humidity_conversion(MS8607_i2c_no_hold);
+  if (status != MS8607_status_ok)
+    return stats_record(MS8607_operation_humidity_adc, status, stats);
+
+  acquisition_hsensor_start = micros();
+  acquisition_hsensor_wait = conversion_timing_wait(
+      &hsensor_timing[hsensor_resolution], hsensor_conversion_time * 1000UL);
+  acquisition_hsensor_state = MS8607_acquisition_humidity_conversion;
+
+  return MS8607_status_ok;
+}
+
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::acquisition_poll_hsensor(void)
+{
+  enum MS8607_status status;
+  uint32_t worst = hsensor_conversion_time * 1000UL;
+
+  if ((acquisition_hsensor_state != MS8607_acquisition_humidity_conversion) ||
+      ((uint32_t)(micros() - acquisition_hsensor_start) < acquisition_hsensor_wait))
+    return MS8607_status_ok;
+
+  status = hsensor_read_humidity_adc(&acquisition_raw.adc_humidity);
+  conversion_timing_update(&hsensor_timing[hsensor_resolution],
+                           acquisition_hsensor_wait, status, worst);
+
+  if (status == MS8607_status_busy)
+  {
+    // NACKed: wait out the rest of the worst case conversion time
+    if (acquisition_hsensor_wait < worst)
+    {
+      acquisition_hsensor_wait = worst;
+      return MS8607_status_ok;
+    }
+
+    conversion_timing_update(&hsensor_timing[hsensor_resolution], worst,
+                             MS8607_status_no_i2c_acknowledge, worst);
+    return stats_record(MS8607_operation_humidity_adc,
+                        MS8607_status_no_i2c_acknowledge,
+                        acquisition_hsensor_start);
+  }
+  stats_record(MS8607_operation_humidity_adc, status, acquisition_hsensor_start);
+  if (status != MS8607_status_ok)
+    return status;
+
+  acquisition_hsensor_state = MS8607_acquisition_complete;
+
+  return MS8607_status_ok;
+}
+
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::acquisition_abort(enum MS8607_status status)
+{
+  acquisition_state = MS8607_acquisition_error;
+  acquisition_status = status;
+  return status;
+}
+
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::acquisition_wait_complete(void)
+{
+  enum MS8607_status status = MS8607_status_ok;
+  uint32_t wait;
+
+  while ((status == MS8607_status_ok) &&
+         (acquisition_state == MS8607_acquisition_temperature_conversion))
+  {
+    wait = getMicrosToNextStep();
+    wait_until(micros(), wait);
+
+    status = poll();
+  }
+
+  return status;
+}
+
+/******************** Conversion timing ********************/
+
+/*
+  \brief Enable or disable adaptive conversion timing.
+
+  \param[in] bool : true to learn the conversion times, false to always wait
+  for the worst case conversion time (default)
+*/
+template <class Bus>
+void MS8607T<Bus>::set_adaptive_timing(bool enable)
+{
+  adaptive_timing = enable;
+  reset_conversion_timing();
+}
+
+/*
+  \brief Time waited for a pressure die conversion before reading the ADC.
+
+  \param[in] MS8607_pressure_resolution : Resolution
+
+  \return uint32_t : microseconds
+*/
+template <class Bus>
+uint32_t
+MS8607T<Bus>::get_pressure_conversion_time(enum MS8607_pressure_resolution res)
+{
+  return conversion_timing_wait(&psensor_timing[res],
+                                psensor_conversion_time[res] * 1000UL);
+}
+
+/*
+  \brief Time waited for a humidity die conversion before reading the ADC.
+
+  \param[in] MS8607_humidity_resolution : Resolution
+
+  \return uint32_t : microseconds
+*/
+template <class Bus>
+uint32_t
+MS8607T<Bus>::get_humidity_conversion_time(enum MS8607_humidity_resolution res)
+{
+  return conversion_timing_wait(&hsensor_timing[res],
+                                hsensor_max_conversion_time(res) * 1000UL);
+}
+
+/*
+  \brief Start every learned conversion time again from the worst case
+*/
+template <class Bus>
+void MS8607T<Bus>::reset_conversion_timing(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < 6; i++)
+  {
+    psensor_timing[i].learned = psensor_conversion_time[i] * 1000UL;
+    psensor_timing[i].settled = false;
+  }
+  for (i = 0; i < 4; i++)
+  {
+    hsensor_timing[i].learned =
+        hsensor_max_conversion_time((enum MS8607_humidity_resolution)i) * 1000UL;
+    hsensor_timing[i].settled = false;
+  }
+}
+
+template <class Bus>
+uint32_t MS8607T<Bus>::conversion_timing_wait(struct conversion_timing *timing,
+                                              uint32_t worst)
+{
+  if (!adaptive_timing || (timing->learned > worst))
+    return worst;
+  return timing->learned;
+}
+
+/*
+  \brief Learn from the outcome of an ADC read made waited us after the
+         conversion command.
+         - ok : the conversion was done; until the first early read, probe a
+           shorter time next time
+         - busy : read too early; settle on waited plus a safety margin of 1/16
+           of the worst case
+         - anything else : fall back to the worst case and learn again
+*/
+template <class Bus>
+void MS8607T<Bus>::conversion_timing_update(struct conversion_timing *timing,
+                                            uint32_t waited,
+                                            enum MS8607_status status,
+                                            uint32_t worst)
+{
+  if (!adaptive_timing)
+    return;
+
+  if (status == MS8607_status_ok)
+  {
+    if (!timing->settled && (waited - waited / 32 >= worst / 4))
+      timing->learned = waited - waited / 32;
+  }
+  else if (status == MS8607_status_busy)
+  {
+    timing->learned = waited + worst / 16;
+    if (timing->learned > worst)
+      timing->learned = worst;
+    timing->settled = true;
+  }
+  else
+  {
+    timing->learned = worst;
+    timing->settled = false;
+  }
+}
+
+/*
+  \brief Wait until us microseconds after start
+*/
+template <class Bus>
+void MS8607T<Bus>::wait_until(uint32_t start, uint32_t us)
+{
+  uint32_t elapsed = micros() - start;
+  if (elapsed >= us)
+    return;
+
+  us -= elapsed;
+  if (us >= 1000)
+    delay(us / 1000);
+  if (us % 1000)
+    delayMicroseconds(us % 1000);
+}
+
+/*
+  \brief Set how failed bus transactions are retried and when the bus is
+         recovered.
+
+  \param[in] MS8607_retry_policy : Retry policy
+*/
+template <class Bus>
+void MS8607T<Bus>::set_retry_policy(struct MS8607_retry_policy policy)
+{
+  retry_policy = policy;
+}
+
+/*
+  \brief Number of bus recoveries since begin()
+
+  \return uint32_t : Recoveries
+*/
+template <class Bus>
+uint32_t MS8607T<Bus>::get_recovery_count(void)
+{
+  return bus_recoveries;
+}
+
+/*
+  \brief Write tx, then read rx if rx_length is not 0, with the retry policy.
+         The read is skipped if the write fails.
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::bus_transfer(enum MS8607_operation operation,
+                                              uint8_t address,
+                                              const uint8_t *tx,
+                                              uint8_t tx_length, uint8_t *rx,
+                                              uint8_t rx_length)
+{
+  enum MS8607_status status;
+  uint32_t start = (retry_policy.deadline_us != 0) ? micros() : 0;
+  uint32_t backoff = retry_policy.backoff_us;
+  uint8_t attempt = 0;
+  uint8_t i2c_status;
+
+  while (true)
+  {
+    i2c_status = bus_write(operation, address, tx, tx_length);
+    if (i2c_status == i2c_status_err_overflow)
+      status = MS8607_status_no_i2c_acknowledge;
+    else if (i2c_status != i2c_status_ok)
+      status = MS8607_status_i2c_transfer_error;
+    else if ((rx_length > 0) &&
+             (bus_read(operation, address, rx, rx_length) < rx_length))
+      status = MS8607_status_i2c_transfer_error;
+    else
+    {
+      bus_failures = 0;
+      return MS8607_status_ok;
+    }
+
+    if (attempt++ >= retry_policy.retries)
+      break;
+    if ((retry_policy.deadline_us != 0) &&
+        ((uint32_t)(micros() - start) + backoff > retry_policy.deadline_us))
+      break;
+
+    wait_until(micros(), backoff);
+    backoff *= 2;
+  }
+
+  if ((retry_policy.recover_after != 0) && !bus_recovering &&
+      (++bus_failures >= retry_policy.recover_after))
+    bus_recover();
+
+  return status;
+}
+
+/*
+  \brief Free the bus, reset both dies and reload the PROM. The humidity
+         resolution and heater are restored.
+*/
+template <class Bus>
+void MS8607T<Bus>::bus_recover(void)
+{
+  enum MS8607_humidity_resolution resolution = hsensor_resolution;
+
+  bus_recovering = true;
+  bus_failures = 0;
+  bus_recoveries++;
+
+  _bus.recover();
+
+  if ((reset() == MS8607_status_ok) &&
+      (psensor_read_eeprom() == MS8607_status_ok))
+  {
+    if (resolution != MS8607_humidity_resolution_12b)
+      set_humidity_resolution(resolution);
+    if (hsensor_heater_on)
+      enable_heater();
+  }
+
+  bus_recovering = false;
+}
+
+/******************** Functions from humidity sensor ********************/
+
+/*
+  \brief Check whether humidity sensor is connected
+
+  \return bool : status of humidity sensor
+        - true : Device is present
+        - false : Device is not acknowledging I2C address
+*/
+template <class Bus>
+bool MS8607T<Bus>::hsensor_is_connected(void)
+{
+  return (bus_write(MS8607_operation_other,
+                    MS8607_HSENSOR_ADDR, NULL, 0) == i2c_status_ok);
+}
+
+/*
+  \brief Reset the humidity sensor part
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::hsensor_reset(void)
+{
+  uint8_t command = HSENSOR_RESET_COMMAND;
+
+  enum MS8607_status status = bus_transfer(
+      MS8607_operation_other, MS8607_HSENSOR_ADDR, &command, 1, NULL, 0);
+  if (status != MS8607_status_ok)
+    return status;
+
+  hsensor_conversion_time = HSENSOR_CONVERSION_TIME_12b;
+  hsensor_resolution = MS8607_humidity_resolution_12b;
+  delay(HSENSOR_RESET_TIME);
+
+  return MS8607_status_ok;
+}
+
+/*
+  \brief Check CRC
+
+  \param[in] const uint8_t* : data on which to check CRC
+  \param[in] uint8_t : number of data bytes
+  \param[in] uint8_t : CRC value
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : CRC check is OK
+        - MS8607_status_crc_error : CRC check error
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::hsensor_crc_check(const uint8_t *data,
+                                                   uint8_t length, uint8_t crc)
+{
+#ifdef MS8607_CRC_NIBBLE_TABLES
+  if (MS8607_crc8_nibble(data, length) == crc)
+#else
+  if (MS8607_crc8(data, length) == crc)
+#endif
+    return MS8607_status_ok;
+  return MS8607_status_crc_error;
+}
+
+/*
+  \brief Reads the MS8607 humidity user register.
+
+  \param[out] uint8_t* : Storage of user register value
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::hsensor_read_user_register(uint8_t *value)
+{
+  uint8_t command = HSENSOR_READ_USER_REG_COMMAND;
+  uint8_t buffer[1];
+  uint32_t stats = stats_start();
+  buffer[0] = 0;
+
+  // Send the Read Register Command and read the register
+  enum MS8607_status status =
+      bus_transfer(MS8607_operation_user_register_read, MS8607_HSENSOR_ADDR,
+                   &command, 1, buffer, 1);
+  if (status != MS8607_status_ok)
+    return stats_record(MS8607_operation_user_register_read, status, stats);
+
+  *value = buffer[0];
+
+  return stats_record(MS8607_operation_user_register_read, MS8607_status_ok,
+                      stats);
+}
+
+/*
+  \brief Send a two byte command and read the answer from the humidity die
+
+  \param[in] uint16_t : Command
+  \param[out] uint8_t* : Answer
+  \param[in] uint8_t : Number of bytes to read
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::hsensor_read_command(uint16_t command, uint8_t *data,
+                                                      uint8_t length)
+{
+  uint8_t buffer[2];
+
+  buffer[0] = (uint8_t)(command >> 8);
+  buffer[1] = (uint8_t)(command & 0xFF);
+
+  return bus_transfer(MS8607_operation_other, MS8607_HSENSOR_ADDR, buffer, 2,
+                      data, length);
+}
+
+/*
+  \brief Reads the serial number of the humidity die from the device.
+         Each byte of SNB carries its own CRC, SNC and SNA one per word.
+
+  \param[out] uint64_t* : Serial number
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+        - MS8607_status_crc_error : CRC check error
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::hsensor_read_serial_number(uint64_t *serial)
+{
+  uint8_t first[8]; // SNB3, CRC, SNB2, CRC, SNB1, CRC, SNB0, CRC
+  uint8_t last[6];  // SNC1, SNC0, CRC, SNA1, SNA0, CRC
+  uint8_t i;
+
+  enum MS8607_status status = hsensor_read_command(
+      HSENSOR_READ_SERIAL_FIRST_8BYTES_COMMAND, first, sizeof(first));
+  if (status != MS8607_status_ok)
+    return status;
+
+  status = hsensor_read_command(HSENSOR_READ_SERIAL_LAST_6BYTES_COMMAND, last,
+                                sizeof(last));
+  if (status != MS8607_status_ok)
+    return status;
+
+  for (i = 0; i < 8; i += 2)
+  {
+    status = hsensor_crc_check(first + i, 1, first[i + 1]);
+    if (status != MS8607_status_ok)
+      return status;
+  }
+  for (i = 0; i < 6; i += 3)
+  {
+    status = hsensor_crc_check(last + i, 2, last[i + 2]);
+    if (status != MS8607_status_ok)
+      return status;
+  }
+
+  *serial = ((uint64_t)first[0] << 56) | ((uint64_t)first[2] << 48) |
+            ((uint64_t)first[4] << 40) | ((uint64_t)first[6] << 32) |
+            ((uint64_t)last[0] << 24) | ((uint64_t)last[1] << 16) |
+            ((uint64_t)last[3] << 8) | (uint64_t)last[4];
+
+  return MS8607_status_ok;
+}
+
+/*
+  \brief Read the 64-bit serial number of the humidity die. The first call
+         reads it from the device, later calls return the cached value until
+         the next begin().
+
+  \param[out] uint64_t* : Serial number
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+        - MS8607_status_crc_error : CRC check error
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::readSerialNumber(uint64_t *serial)
+{
+  if (!hsensor_serial_number_valid)
+  {
+    enum MS8607_status status = hsensor_read_serial_number(&hsensor_serial_number);
+    if (status != MS8607_status_ok)
+      return status;
+    hsensor_serial_number_valid = true;
+  }
+
+  *serial = hsensor_serial_number;
+
+  return MS8607_status_ok;
+}
+
+/*
+  \brief Writes the MS8607 humidity user register with value
+         Will read and keep the unreserved bits of the register
+
+  \param[in] uint8_t : Register value to be set.
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::hsensor_write_user_register(uint8_t value)
+{
+  uint8_t reg;
+  uint8_t buffer[2];
+  uint32_t stats;
+
+  enum MS8607_status status = hsensor_read_user_register(&reg);
+  if (status != MS8607_status_ok)
+    return status;
+
+  // Clear bits of reg that are not reserved
+  reg &= HSENSOR_USER_REG_RESERVED_MASK;
+  // Set bits from value that are not reserved
+  reg |= (value & ~HSENSOR_USER_REG_RESERVED_MASK);
+
+  buffer[0] = HSENSOR_WRITE_USER_REG_COMMAND;
+  buffer[1] = reg;
+  stats = stats_start();
+
+  /* Do the transfer */
+  status = bus_transfer(MS8607_operation_user_register_write,
+                        MS8607_HSENSOR_ADDR, buffer, 2, NULL, 0);
+
+  return stats_record(MS8607_operation_user_register_write, status, stats);
+}
+
+/*
+  \brief Set humidity ADC resolution.
+
+  \param[in] MS8607_humidity_resolution : Resolution requested
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+        - MS8607_status_crc_error : CRC check error
+*/
+template <class Bus>
+enum MS8607_status
+MS8607T<Bus>::set_humidity_resolution(enum MS8607_humidity_resolution res)
+{
+  uint8_t reg_value, tmp = 0;
+  uint32_t conversion_time = HSENSOR_CONVERSION_TIME_12b;
+
+  if (res == MS8607_humidity_resolution_12b)
+  {
+    tmp = HSENSOR_USER_REG_RESOLUTION_12b;
+    conversion_time = HSENSOR_CONVERSION_TIME_12b;
+  }
+  else if (res == MS8607_humidity_resolution_10b)
+  {
+    tmp = HSENSOR_USER_REG_RESOLUTION_10b;
+    conversion_time = HSENSOR_CONVERSION_TIME_10b;
+  }
+  else if (res == MS8607_humidity_resolution_8b)
+  {
+    tmp = HSENSOR_USER_REG_RESOLUTION_8b;
+    conversion_time = HSENSOR_CONVERSION_TIME_8b;
+  }
+  else if (res == MS8607_humidity_resolution_11b)
+  {
+    tmp = HSENSOR_USER_REG_RESOLUTION_11b;
+    conversion_time = HSENSOR_CONVERSION_TIME_11b;
+  }
+
+  enum MS8607_status status = hsensor_read_user_register(&reg_value);
+  if (status != MS8607_status_ok)
+    return status;
+
+  // Clear the resolution bits
+  reg_value &= ~HSENSOR_USER_REG_RESOLUTION_MASK;
+  reg_value |= tmp & HSENSOR_USER_REG_RESOLUTION_MASK;
+
+  hsensor_conversion_time = conversion_time;
+  hsensor_resolution = res;
+
+  status = hsensor_write_user_register(reg_value);
+
+  return status;
+}
+
+/*
+  \brief Reads the relative humidity ADC value
+
+  \param[out] uint16_t* : Relative humidity ADC value.
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer, or a
+          short read in hold mode
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge, or the
+          conversion was still not done after the worst case time in no hold
+          mode
+        - MS8607_status_crc_error : CRC check error
+*/
+template <class Bus>
+enum MS8607_status
+MS8607T<Bus>::hsensor_humidity_conversion_and_read_adc(uint16_t *adc)
+{
+  struct conversion_timing *timing = &hsensor_timing[hsensor_resolution];
+  uint32_t worst = hsensor_conversion_time * 1000UL;
+  uint32_t wait, start;
+  uint32_t stats = stats_start();
+
+  enum MS8607_status status =
+      hsensor_start_humidity_conversion(hsensor_i2c_master_mode);
+  if (status != MS8607_status_ok)
+    return stats_record(MS8607_operation_humidity_adc, status, stats);
+
+  if (hsensor_i2c_master_mode == MS8607_i2c_hold)
+  {
+    // The die stretches the clock until the conversion is done, so a short
+    // read is a failed transfer, not a conversion in progress
+    status = hsensor_read_humidity_adc(adc);
+    if (status == MS8607_status_busy)
+      status = MS8607_status_i2c_transfer_error;
+    return stats_record(MS8607_operation_humidity_adc, status, stats);
+  }
+
+  // In no hold mode, delay depending on resolution
+  start = micros();
+  wait = conversion_timing_wait(timing, worst);
+  wait_until(start, wait);
+
+  status = hsensor_read_humidity_adc(adc);
+  conversion_timing_update(timing, wait, status, worst);
+
+  // NACKed: wait out the rest of the worst case conversion time
+  if ((status == MS8607_status_busy) && (wait < worst))
+  {
+    wait_until(start, worst);
+    status = hsensor_read_humidity_adc(adc);
+  }
+  if (status == MS8607_status_busy)
+    status = MS8607_status_no_i2c_acknowledge;
+  if (status != MS8607_status_ok)
+    conversion_timing_update(timing, worst, status, worst);
+
+  return stats_record(MS8607_operation_humidity_adc, status, stats);
+}
+
+/*
+  \brief Worst case conversion time of a humidity resolution
+
+  \param[in] MS8607_humidity_resolution : Resolution
+
+  \return uint32_t : milliseconds
+*/
+template <class Bus>
+uint32_t
+MS8607T<Bus>::hsensor_max_conversion_time(enum MS8607_humidity_resolution res)
+{
+  if (res == MS8607_humidity_resolution_8b)
+    return HSENSOR_CONVERSION_TIME_8b;
+  if (res == MS8607_humidity_resolution_10b)
+    return HSENSOR_CONVERSION_TIME_10b;
+  if (res == MS8607_humidity_resolution_11b)
+    return HSENSOR_CONVERSION_TIME_11b;
+  return HSENSOR_CONVERSION_TIME_12b;
+}
+
+/*
+  \brief Sends the relative humidity measurement command
+
+  \param[in] MS8607_i2c_master_mode : Hold or no hold master command
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::hsensor_start_humidity_conversion(
+    enum MS8607_humidity_i2c_master_mode mode)
+{
+  uint8_t command;
+
+  if (mode == MS8607_i2c_hold)
+    command = HSENSOR_READ_HUMIDITY_W_HOLD_COMMAND;
+  else
+    command = HSENSOR_READ_HUMIDITY_WO_HOLD_COMMAND;
+
+  return bus_transfer(MS8607_operation_humidity_adc, MS8607_HSENSOR_ADDR,
+                      &command, 1, NULL, 0);
+}
+
+/*
+  \brief Reads and CRC checks the relative humidity ADC value of the last
+         measurement command
+
+  \param[out] uint16_t* : Relative humidity ADC value.
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_busy : Conversion not complete (read NACKed)
+        - MS8607_status_crc_error : CRC check error
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::hsensor_read_humidity_adc(uint16_t *adc)
+{
+  enum MS8607_status status = MS8607_status_ok;
+  uint16_t _adc;
+  uint8_t buffer[3];
+
+  // In no hold mode the die NACKs its address until the conversion is done
+  if (bus_read(MS8607_operation_humidity_adc,
+               MS8607_HSENSOR_ADDR, buffer, 3) < 3)
+    return MS8607_status_busy;
+
+  // compute CRC
+  status = hsensor_crc_check(buffer, 2, buffer[2]);
+  if (status != MS8607_status_ok)
+    return status;
+
+  _adc = (buffer[0] << 8) | buffer[1];
+
+  *adc = _adc;
+
+  return status;
+}
+
+/*
+  \brief Returns result of compensated humidity
+         Note : This function shall only be used when the heater is OFF. It
+  will return an error otherwise.
+
+  \param[in] float - Actual temperature measured (degC)
+  \param[in] float - Actual relative humidity measured (%RH)
+  \param[out] float *- Compensated humidity (%RH).
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_heater_on_error : Cannot compute compensated humidity
+  because heater is on
+*/
+template <class Bus>
+enum MS8607_status
+MS8607T<Bus>::get_compensated_humidity(float temperature, float relative_humidity,
+                                       float *compensated_humidity)
+{
+  if (hsensor_heater_on)
+    return MS8607_status_heater_on_error;
+
+  *compensated_humidity =
+      (relative_humidity +
+       (25 - temperature) * HSENSOR_TEMPERATURE_COEFFICIENT);
+
+  return MS8607_status_ok;
+}
+
+/*
+  \brief Returns the computed dew point
+         Note : This function shall only be used when the heater is OFF. It
+  will return an error otherwise.
+
+  \param[in] float - Actual temperature measured (degC)
+  \param[in] float - Actual relative humidity measured (%RH)
+  \param[out] float *- Dew point temperature (DegC).
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_heater_on_error : Cannot compute compensated humidity
+  because heater is on
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::get_dew_point(float temperature,
+                                               float relative_humidity,
+                                               float *dew_point)
+{
+  if (hsensor_heater_on)
+    return MS8607_status_heater_on_error;
+
+#ifdef MS8607_FAST_MATH
+  *dew_point = MS8607_dew_point_fast(temperature, relative_humidity);
+#else
+  double partial_pressure;
+
+  // Missing power of 10
+  partial_pressure =
+      pow(10, HSENSOR_CONSTANT_A -
+                  HSENSOR_CONSTANT_B / (temperature + HSENSOR_CONSTANT_C));
+
+  *dew_point =
+      -HSENSOR_CONSTANT_B / (log10(relative_humidity * partial_pressure / 100) -
+                             HSENSOR_CONSTANT_A) -
+      HSENSOR_CONSTANT_C;
+#endif
+
+  return MS8607_status_ok;
+}
+
+/******************** Functions from Pressure sensor ********************/
+
+/*
+  \brief Check whether MS8607 pressure sensor is connected
+
+  \return bool : status of MS8607
+        - true : Device is present
+        - false : Device is not acknowledging I2C address
+*/
+template <class Bus>
+bool MS8607T<Bus>::psensor_is_connected(void)
+{
+  return (bus_write(MS8607_operation_other,
+                    MS8607_PSENSOR_ADDR, NULL, 0) == i2c_status_ok);
+}
+
+/*
+  \brief Reset the Pressure sensor part
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::psensor_reset(void)
+{
+  uint8_t command = PSENSOR_RESET_COMMAND;
+
+  enum MS8607_status status = bus_transfer(
+      MS8607_operation_other, MS8607_PSENSOR_ADDR, &command, 1, NULL, 0);
+
+  psensor_temperature_valid = false;
+
+  return status;
+}
+
+/*
+  \brief CRC check
+
+  \param[in] uint16_t *: List of EEPROM coefficients
+  \param[in] uint8_t : crc to compare
+
+  \return bool : TRUE if CRC is OK, FALSE if KO
+*/
+template <class Bus>
+bool MS8607T<Bus>::psensor_crc_check(const uint16_t *n_prom, uint8_t crc)
+{
+#ifdef MS8607_CRC_NIBBLE_TABLES
+  return MS8607_crc4_nibble(n_prom) == crc;
+#else
+  return MS8607_crc4(n_prom) == crc;
+#endif
+}
+
+/*
+  \brief Set pressure ADC resolution.
+
+  \param[in] MS8607_pressure_resolution : Resolution requested
+
+*/
+template <class Bus>
+void MS8607T<Bus>::set_pressure_resolution(enum MS8607_pressure_resolution res)
+{
+  psensor_resolution_osr = res;
+}
+
+/*
+  \brief Reads the psensor EEPROM coefficient stored at address provided.
+
+  \param[in] uint8_t : Address of coefficient in EEPROM
+  \param[out] uint16_t* : Value read in EEPROM
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+        - MS8607_status_crc_error : CRC check error on the coefficients
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::psensor_read_eeprom_coeff(uint8_t command,
+                                                           uint16_t *coeff)
+{
+  uint8_t buffer[2];
+  uint32_t stats = stats_start();
+
+  /* Read data */
+  enum MS8607_status status =
+      bus_transfer(MS8607_operation_prom_read, MS8607_PSENSOR_ADDR, &command, 1,
+                   buffer, 2);
+  if (status != MS8607_status_ok)
+    return stats_record(MS8607_operation_prom_read, status, stats);
+
+  *coeff = (buffer[0] << 8) | buffer[1];
+
+  if (*coeff == 0)
+    return stats_record(MS8607_operation_prom_read,
+                        MS8607_status_i2c_transfer_error, stats);
+
+  return stats_record(MS8607_operation_prom_read, MS8607_status_ok, stats);
+}
+
+/*
+  \brief Reads the MS8607 EEPROM coefficients to store them for computation.
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+        - MS8607_status_crc_error : CRC check error on the coefficients
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::psensor_read_eeprom(void)
+{
+  enum MS8607_status status;
+  uint8_t i;
+
+  // The cached temperature terms depend on the coefficients
+  psensor_terms_adc = 0;
+
+  for (i = 0; i < COEFFICIENT_NUMBERS; i++)
+  {
+    status = psensor_read_eeprom_coeff(PROM_ADDRESS_READ_ADDRESS_0 + i * 2,
+                                       eeprom_coeff + i);
+    if (status != MS8607_status_ok)
+      return status;
+  }
+
+  if (!psensor_crc_check(eeprom_coeff,
+                         (eeprom_coeff[CRC_INDEX] & 0xF000) >> 12))
+    return MS8607_status_crc_error;
+
+  return MS8607_status_ok;
+}
+
+/*
+  \brief Get the EEPROM coefficients from the PROM cache when it is valid,
+         or read them from the device and refresh the cache.
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+        - MS8607_status_crc_error : CRC check error on the coefficients
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::psensor_load_eeprom(void)
+{
+  struct MS8607_prom_cache loaded;
+  enum MS8607_status status;
+  bool restored = false;
+  uint64_t serial = 0;
+  uint16_t word;
+  uint8_t i;
+
+  prom_cache_used = false;
+
+  // The serial number identifies the device even if its PROM is identical
+  if (prom_cache_mode == MS8607_prom_cache_verify_serial)
+  {
+    status = readSerialNumber(&serial);
+    if (status != MS8607_status_ok)
+      return status;
+  }
+
+  if (prom_cache != NULL)
+    restored = prom_cache_restore(prom_cache, serial);
+  if (!restored && (prom_cache_load != NULL) &&
+      prom_cache_load(&loaded, prom_cache_context))
+    restored = prom_cache_restore(&loaded, serial);
+
+  if (restored && (prom_cache_mode != MS8607_prom_cache_verify))
+  {
+    prom_cache_used = true;
+    return MS8607_status_ok;
+  }
+
+  if (restored)
+  {
+    // Word 0 only holds a 4-bit CRC next to factory bits shared by all parts,
+    // so a swapped device matches it 1 time in 16. It must also match C1
+    // (SENS_T1), a 16-bit per device calibration. Fall back to a full read on
+    // a mismatch or a failed transfer.
+    status = psensor_read_eeprom_coeff(PROM_ADDRESS_READ_ADDRESS_0, &word);
+    if ((status == MS8607_status_ok) && (word == eeprom_coeff[CRC_INDEX]))
+      status = psensor_read_eeprom_coeff(PROM_ADDRESS_READ_ADDRESS_1, &word);
+    else
+      status = MS8607_status_crc_error;
+    if ((status == MS8607_status_ok) &&
+        (word == eeprom_coeff[PRESSURE_SENSITIVITY_INDEX]))
+    {
+      prom_cache_used = true;
+      return MS8607_status_ok;
+    }
+  }
+
+  status = psensor_read_eeprom();
+  if (status != MS8607_status_ok)
+    return status;
+
+  loaded.magic = MS8607_PROM_CACHE_MAGIC;
+  for (i = 0; i < COEFFICIENT_NUMBERS; i++)
+    loaded.coeff[i] = eeprom_coeff[i];
+  loaded.serial = hsensor_serial_number_valid ? hsensor_serial_number : 0;
+
+  if (prom_cache != NULL)
+    *prom_cache = loaded;
+  if (prom_cache_store != NULL)
+    prom_cache_store(&loaded, prom_cache_context);
+
+  return MS8607_status_ok;
+}
+
+template <class Bus>
+bool MS8607T<Bus>::prom_cache_restore(const struct MS8607_prom_cache *cache,
+                                      uint64_t serial)
+{
+  uint16_t coeff[COEFFICIENT_NUMBERS];
+  uint8_t i;
+
+  if (cache->magic != MS8607_PROM_CACHE_MAGIC)
+    return false;
+
+  if ((prom_cache_mode == MS8607_prom_cache_verify_serial) &&
+      ((serial == 0) || (cache->serial != serial)))
+    return false;
+
+  for (i = 0; i < COEFFICIENT_NUMBERS; i++)
+    coeff[i] = cache->coeff[i];
+
+  if (!psensor_crc_check(coeff, (coeff[CRC_INDEX] & 0xF000) >> 12))
+    return false;
+
+  for (i = 0; i < COEFFICIENT_NUMBERS; i++)
+    eeprom_coeff[i] = coeff[i];
+  psensor_terms_adc = 0;
+
+  return true;
+}
+
+/*
+  \brief Use a buffer as the PROM coefficient cache. Call before begin().
+
+  \param[in] MS8607_prom_cache* : Cache buffer, NULL to disable
+  \param[in] MS8607_prom_cache_mode : verify or trust the cache
+*/
+template <class Bus>
+void MS8607T<Bus>::set_prom_cache(struct MS8607_prom_cache *cache,
+                                  enum MS8607_prom_cache_mode mode)
+{
+  prom_cache = cache;
+  prom_cache_mode = mode;
+}
+
+/*
+  \brief Use callbacks as the PROM coefficient cache. Call before begin().
+
+  \param[in] MS8607_prom_cache_load : Load callback, may be NULL
+  \param[in] MS8607_prom_cache_store : Store callback, may be NULL
+  \param[in] void* : Passed unchanged to the callbacks
+  \param[in] MS8607_prom_cache_mode : verify or trust the cache
+*/
+template <class Bus>
+void MS8607T<Bus>::set_prom_cache_callbacks(MS8607_prom_cache_load load,
+                                            MS8607_prom_cache_store store,
+                                            void *context,
+                                            enum MS8607_prom_cache_mode mode)
+{
+  prom_cache_load = load;
+  prom_cache_store = store;
+  prom_cache_context = context;
+  prom_cache_mode = mode;
+}
+
+/*
+  \brief Check whether begin() took the coefficients from the cache
+
+  \return bool : true if the full PROM read was skipped
+*/
+template <class Bus>
+bool MS8607T<Bus>::prom_cache_hit(void)
+{
+  return prom_cache_used;
+}
+
+/*
+  \brief Triggers conversion and read ADC value. A busy read (ADC value of 0)
+         corrupts the conversion, so it is restarted once and read after the
+         worst case conversion time.
+
+  \param[in] uint8_t : Command used for conversion (will determine Temperature
+  vs Pressure and osr)
+  \param[out] uint32_t* : ADC value.
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::psensor_conversion_and_read_adc(uint8_t cmd,
+                                                                 uint32_t *adc)
+{
+  struct conversion_timing *timing = &psensor_timing[psensor_resolution_osr];
+  uint32_t worst = psensor_conversion_time[psensor_resolution_osr] * 1000UL;
+  uint32_t wait, start;
+  uint32_t stats = stats_start();
+
+  enum MS8607_status status = psensor_start_conversion(cmd);
+  if (status != MS8607_status_ok)
+    return stats_record(MS8607_operation_pressure_adc, status, stats);
+
+  // 20ms wait for conversion
+  //delay(psensor_conversion_time[(cmd & PSENSOR_CONVERSION_OSR_MASK) / 2]);
+  start = micros();
+  wait = conversion_timing_wait(timing, worst);
+  wait_until(start, wait);
+
+  status = psensor_read_adc(adc);
+  conversion_timing_update(timing, wait, status, worst);
+
+  // A read before the end of the conversion corrupts it, so whether it came
+  // too early or the conversion was lost, run it once more
+  if (status == MS8607_status_busy)
+  {
+    if (wait >= worst)
+      conversion_timing_update(timing, worst, MS8607_status_i2c_transfer_error, worst);
+    status = psensor_start_conversion(cmd);
+    if (status != MS8607_status_ok)
+      return stats_record(MS8607_operation_pressure_adc, status, stats);
+
+    delay(psensor_conversion_time[psensor_resolution_osr]);
+    status = psensor_read_adc(adc);
+  }
+
+  if (status == MS8607_status_busy)
+    status = MS8607_status_i2c_transfer_error;
+  if (status != MS8607_status_ok)
+    conversion_timing_update(timing, worst, status, worst);
+
+  return stats_record(MS8607_operation_pressure_adc, status, stats);
+}
+
+/*
+  \brief Sends a conversion command
+
+  \param[in] uint8_t : Command used for conversion (will determine Temperature
+  vs Pressure and osr)
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::psensor_start_conversion(uint8_t cmd)
+{
+  return bus_transfer(MS8607_operation_pressure_adc, MS8607_PSENSOR_ADDR, &cmd,
+                      1, NULL, 0);
+}
+
+/*
+  \brief Reads the ADC value of the last conversion
+
+  \param[out] uint32_t* : ADC value.
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_busy : Conversion not complete (ADC read 0)
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::psensor_read_adc(uint32_t *adc)
+{
+  uint8_t command = PSENSOR_READ_ADC;
+  uint8_t buffer[3];
+
+  // Send the read command and read the result
+  enum MS8607_status status =
+      bus_transfer(MS8607_operation_pressure_adc, MS8607_PSENSOR_ADDR, &command,
+                   1, buffer, 3);
+  if (status != MS8607_status_ok)
+    return status;
+
+  *adc = ((uint32_t)buffer[0] << 16) | ((uint32_t)buffer[1] << 8) | buffer[2];
+
+  // The ADC reads 0 if the conversion has not completed
+  if (*adc == 0)
+    return MS8607_status_busy;
+
+  return MS8607_status_ok;
+}
+
+/*
+  \brief Convert D1 and, when needed, D2. A temperature only acquisition
+         always converts D2.
+
+  \param[in] uint8_t : MS8607_channel bits, temperature and/or pressure
+  \param[out] MS8607_raw_sample* : D1 and D2 words
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : I2C transfer completed successfully
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::psensor_read_raw(uint8_t channels,
+                                                  struct MS8607_raw_sample *raw)
+{
+  uint32_t adc_temperature, adc_pressure;
+  enum MS8607_status status;
+  uint8_t cmd;
+
+  // First read temperature, unless the cached D2 can be reused
+  if (!(channels & MS8607_channel_pressure) || psensor_temperature_refresh_due())
+  {
+    cmd = psensor_resolution_osr * 2;
+    cmd |= PSENSOR_START_TEMPERATURE_ADC_CONVERSION;
+    status = psensor_conversion_and_read_adc(cmd, &adc_temperature);
+    if (status != MS8607_status_ok)
+      return status;
+
+    status = psensor_store_temperature(adc_temperature);
+    if (status != MS8607_status_ok)
+      return status;
+  }
+  raw->adc_temperature = psensor_adc_temperature;
+
+  if (!(channels & MS8607_channel_pressure))
+    return MS8607_status_ok;
+
+  // Now read pressure
+  cmd = psensor_resolution_osr * 2;
+  cmd |= PSENSOR_START_PRESSURE_ADC_CONVERSION;
+  status = psensor_conversion_and_read_adc(cmd, &adc_pressure);
+  if (status != MS8607_status_ok)
+    return status;
+
+  status = psensor_store_pressure(adc_pressure);
+  if (status != MS8607_status_ok)
+    return status;
+  raw->adc_pressure = adc_pressure;
+
+  return MS8607_status_ok;
+}
+
+/*
+  \brief Set how often the temperature (D2) conversion is refreshed.
+
+  \param[in] uint16_t : Refresh D2 at least every n pressure samples
+          (1 = every sample, 0 = no sample limit)
+  \param[in] uint32_t : Refresh D2 at least every interval ms (0 = no time limit)
+*/
+template <class Bus>
+void MS8607T<Bus>::set_temperature_refresh(uint16_t samples, uint32_t interval)
+{
+  psensor_temperature_refresh_samples = samples;
+  psensor_temperature_refresh_interval = interval;
+}
+
+/*
+  \brief Discard the cached temperature terms so the next pressure sample
+         starts with a D2 conversion.
+*/
+template <class Bus>
+void MS8607T<Bus>::invalidate_temperature(void)
+{
+  psensor_temperature_valid = false;
+}
+
+/*
+  \brief Check whether the next pressure sample needs a new D2 conversion
+
+  \return bool : true if D2 must be converted
+*/
+template <class Bus>
+bool MS8607T<Bus>::psensor_temperature_refresh_due(void)
+{
+  if (!psensor_temperature_valid)
+    return true;
+
+  // No limits set: refresh on every sample
+  if ((psensor_temperature_refresh_samples == 0) &&
+      (psensor_temperature_refresh_interval == 0))
+    return true;
+
+  if ((psensor_temperature_refresh_samples != 0) &&
+      (psensor_temperature_samples >= psensor_temperature_refresh_samples))
+    return true;
+
+  if ((psensor_temperature_refresh_interval != 0) &&
+      ((millis() - psensor_temperature_time) >= psensor_temperature_refresh_interval))
+    return true;
+
+  return false;
+}
+
+/*
+  \brief Store a D2 ADC value as the cached temperature
+
+  \param[in] uint32_t : D2 temperature ADC value
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : Value stored
+        - MS8607_status_i2c_transfer_error : ADC value is 0
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::psensor_store_temperature(uint32_t adc_temperature)
+{
+  if (adc_temperature == 0)
+    return MS8607_status_i2c_transfer_error;
+
+  psensor_adc_temperature = adc_temperature;
+  psensor_temperature_valid = true;
+  psensor_temperature_samples = 0;
+  psensor_temperature_time = millis();
+
+  return MS8607_status_ok;
+}
+
+/*
+  \brief Check a D1 ADC value and count it against the cached temperature
+
+  \param[in] uint32_t : D1 pressure ADC value
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : Value accepted
+        - MS8607_status_i2c_transfer_error : ADC value is 0
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::psensor_store_pressure(uint32_t adc_pressure)
+{
+  if (adc_pressure == 0)
+    return MS8607_status_i2c_transfer_error;
+
+  psensor_temperature_samples++;
+
+  return MS8607_status_ok;
+}
+
+/*
+  \brief Compensate a raw sample
+
+  \param[in] const MS8607_raw_sample* : Raw sample
+  \param[out] MS8607_sample_fixed* : Values of the channels of the raw sample
+*/
+template <class Bus>
+void MS8607T<Bus>::compensate_raw(const struct MS8607_raw_sample *raw,
+                                  struct MS8607_sample_fixed *values)
+{
+  values->temperature = 0;
+  values->pressure = 0;
+  values->humidity = 0;
+
+  if (raw->channels & MS8607_channel_temperature)
+  {
+    // Second order compensation, see SparkFun_PHT_MS8607_Compensation.cpp
+    if (raw->adc_temperature != psensor_terms_adc)
+    {
+      MS8607_compensate_temperature(eeprom_coeff, raw->adc_temperature,
+                                    &psensor_terms);
+      psensor_terms_adc = raw->adc_temperature;
+    }
+    values->temperature = psensor_terms.temperature;
+
+    // Temperature compensated pressure = D1 * SENS - OFF
+    if (raw->channels & MS8607_channel_pressure)
+      values->pressure = MS8607_compensate_pressure(&psensor_terms, raw->adc_pressure);
+  }
+
+  if (raw->channels & MS8607_channel_humidity)
+    values->humidity = MS8607_compensate_humidity(raw->adc_humidity);
+}
+
+//Returns the latest pressure reading. Will initiate a reading if data is expired
+template <class Bus>
+float MS8607T<Bus>::getPressure()
+{
+  sample_refresh(MS8607_channel_pressure);
+  sample_compensate();
+  sample_consumed |= MS8607_channel_pressure;
+  return ((float)sample.pressure / 100);
+}
+
+//Returns the latest temp reading. Will initiate a reading if data is expired
+template <class Bus>
+float MS8607T<Bus>::getTemperature()
+{
+  sample_refresh(MS8607_channel_temperature);
+  sample_compensate();
+  sample_consumed |= MS8607_channel_temperature;
+  return ((float)sample.temperature / 100);
+}
+
+//Returns the latest humidity reading. Will initiate a reading if data is expired
+template <class Bus>
+float MS8607T<Bus>::getHumidity()
+{
+  sample_refresh(MS8607_channel_humidity);
+  sample_compensate();
+  sample_consumed |= MS8607_channel_humidity;
+  return ((float)sample.humidity / 100);
+}
+
+/*
+  \brief Set the freshness policy of the sample served by the getters.
+
+  \param[in] uint32_t : Max sample age in ms, 0 = each value is used once
+*/
+template <class Bus>
+void MS8607T<Bus>::set_max_sample_age(uint32_t max_age)
+{
+  sample_max_age = max_age;
+}
+
+/*
+  \brief Get the cached sample, making a new acquisition if it is stale
+
+  \param[out] MS8607_sample* : Sample
+
+  \return MS8607_status : status of MS8607
+        - MS8607_status_ok : Sample is valid
+        - MS8607_status_i2c_transfer_error : Problem with i2c transfer
+        - MS8607_status_no_i2c_acknowledge : I2C did not acknowledge
+        - MS8607_status_crc_error : CRC check error
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::getSample(struct MS8607_sample *sample_out)
+{
+  struct MS8607_sample_fixed fixed;
+
+  enum MS8607_status status = getSample_fixed(&fixed);
+  if (status != MS8607_status_ok)
+    return status;
+
+  sample_out->temperature = (float)fixed.temperature / 100;
+  sample_out->pressure = (float)fixed.pressure / 100;
+  sample_out->humidity = (float)fixed.humidity / 100;
+  sample_out->timestamp = fixed.timestamp;
+  sample_out->sequence = fixed.sequence;
+  sample_out->channels = fixed.channels;
+
+  return MS8607_status_ok;
+}
+
+/*
+  \brief getSample() in integer units
+
+  \param[out] MS8607_sample_fixed* : Sample
+
+  \return MS8607_status : as getSample()
+*/
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::getSample_fixed(struct MS8607_sample_fixed *sample_out)
+{
+  enum MS8607_status status = sample_refresh(sample_channels);
+  if (status != MS8607_status_ok)
+    return status;
+
+  sample_compensate();
+  sample_consumed |= sample.channels;
+  *sample_out = sample;
+
+  return MS8607_status_ok;
+}
+
+/*
+  \brief Sequence number of the sample returned by the last getter call
+*/
+template <class Bus>
+uint32_t MS8607T<Bus>::getSampleSequence(void)
+{
+  return sample.sequence;
+}
+
+/*
+  \brief Discard the cached sample so the next getter makes an acquisition
+*/
+template <class Bus>
+void MS8607T<Bus>::invalidateSample(void)
+{
+  sample.channels = 0;
+}
+
+/*
+  \brief Set the channels acquired when a getter finds the sample stale.
+         A getter always acquires its own channel as well.
+
+  \param[in] uint8_t : MS8607_channel bits (default MS8607_channel_all)
+*/
+template <class Bus>
+void MS8607T<Bus>::set_sample_channels(uint8_t channels)
+{
+  sample_channels = channels & MS8607_channel_all;
+}
+
+/*
+  \brief Push every completed acquisition into a ring
+
+  \param[in] MS8607_ring_base* : Ring, NULL to stop pushing
+*/
+template <class Bus>
+void MS8607T<Bus>::set_sample_ring(MS8607_ring_base *ring)
+{
+  sample_ring = ring;
+}
+
+template <class Bus>
+void MS8607T<Bus>::sample_store(const struct MS8607_raw_sample *raw)
+{
+  sample_raw = *raw;
+  sample_compensated = false;
+  sample.timestamp = millis();
+  sample.sequence++;
+  if (sample.sequence == 0)
+    sample.sequence = 1;
+  sample.channels = raw->channels;
+  sample_consumed = 0;
+
+  if (sample_ring != NULL)
+  {
+    sample_compensate();
+    sample_ring->push(&sample);
+  }
+}
+
+template <class Bus>
+void MS8607T<Bus>::sample_compensate(void)
+{
+  struct MS8607_sample_fixed values;
+
+  if (sample_compensated)
+    return;
+
+  compensate_raw(&sample_raw, &values);
+  sample.temperature = values.temperature;
+  sample.pressure = values.pressure;
+  sample.humidity = values.humidity;
+  sample_compensated = true;
+}
+
+template <class Bus>
+void MS8607T<Bus>::sample_copy(float *t, float *p, float *h)
+{
+  sample_compensate();
+  if ((t != NULL) && (sample.channels & MS8607_channel_temperature))
+    *t = (float)sample.temperature / 100;
+  if ((p != NULL) && (sample.channels & MS8607_channel_pressure))
+    *p = (float)sample.pressure / 100;
+  if ((h != NULL) && (sample.channels & MS8607_channel_humidity))
+    *h = (float)sample.humidity / 100;
+}
+
+template <class Bus>
+void MS8607T<Bus>::sample_copy_fixed(int32_t *t, int32_t *p, int32_t *h)
+{
+  sample_compensate();
+  if ((t != NULL) && (sample.channels & MS8607_channel_temperature))
+    *t = sample.temperature;
+  if ((p != NULL) && (sample.channels & MS8607_channel_pressure))
+    *p = sample.pressure;
+  if ((h != NULL) && (sample.channels & MS8607_channel_humidity))
+    *h = sample.humidity;
+}
+
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::sample_refresh(uint8_t channel)
+{
+  int32_t t, p, h;
+
+  if ((sample.channels & channel) == channel)
+  {
+    if (sample_max_age == 0)
+    {
+      if ((sample_consumed & channel) == 0)
+        return MS8607_status_ok;
+    }
+    else if ((millis() - sample.timestamp) <= sample_max_age)
+      return MS8607_status_ok;
+  }
+
+  //Get a new reading. It is stored by read_temperature_pressure_humidity()
+  return read_temperature_pressure_humidity_fixed(&t, &p, &h,
+                                                  sample_channels | channel);
+}
+
+// Given a pressure P (mb) taken at a specific altitude (meters),
+// return the equivalent pressure (mb) at sea level.
+// This produces pressure readings that can be used for weather measurements.
+// Returns pressure in mb
+template <class Bus>
+double MS8607T<Bus>::adjustToSeaLevel(double absolutePressure, double actualAltitude)
+{
+#ifdef MS8607_FAST_MATH
+  return MS8607_sea_level_pressure_fast((float)absolutePressure, (float)actualAltitude);
+#else
+  return (absolutePressure / pow(1 - (actualAltitude / 44330.0), 5.255));
+#endif
+}
+
+// Given a pressure measurement (mb) and the pressure at a baseline (mb),
+// return altitude change (in meters) for the delta in pressures.
+template <class Bus>
+double MS8607T<Bus>::altitudeChange(double currentPressure, double baselinePressure)
+{
+#ifdef MS8607_FAST_MATH
+  return MS8607_altitude_change_fast((float)currentPressure, (float)baselinePressure);
+#else
+  return (44330.0 * (1 - pow(currentPressure / baselinePressure, 1 / 5.255)));
+#endif
+}
+
+#ifdef MS8607_ENABLE_STATS
+/*
+  \brief Get a snapshot of the bus operation statistics
+
+  \param[out] MS8607_stats* : Counters and histograms since resetStats()
+*/
+template <class Bus>
+void MS8607T<Bus>::getStats(struct MS8607_stats *snapshot)
+{
+  *snapshot = stats;
+}
+
+/*
+  \brief Clear the bus operation statistics
+*/
+template <class Bus>
+void MS8607T<Bus>::resetStats(void)
+{
+  memset(&stats, 0, sizeof(stats));
+}
+
+template <class Bus>
+enum MS8607_status MS8607T<Bus>::stats_record(enum MS8607_operation operation,
+                                              enum MS8607_status status,
+                                              uint32_t start)
+{
+  struct MS8607_operation_stats *op = &stats.operation[operation];
+  uint32_t latency = micros() - start;
+  uint8_t bucket = 0;
+
+  while ((bucket < MS8607_STATS_BUCKETS - 1) && (latency >= (128UL << bucket)))
+    bucket++;
+
+  op->count++;
+  op->status[status]++;
+  op->latency[bucket]++;
+
+  return status;
+}
+#endif
+
+#endif
@@ -0,0 +1,98 @@
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include "SparkFun_PHT_MS8607_CRC.h"
+
+// Table entries, generated by the compiler from the bit loops
+#define MS8607_CRC8_BYTE(i) MS8607_crc8_shift((i), 8)
+#define MS8607_CRC8_NIBBLE(i) MS8607_crc8_shift((i) << 4, 4)
+// The CRC-4 polynomial only has bits 12 and 13, so shifting the top byte
+// (nibble) out of the register only leaves bits in the top nibble: store that.
+#define MS8607_CRC4_BYTE(i) (uint8_t)(MS8607_crc4_shift((i) << 8, 8) >> 12)
+#define MS8607_CRC4_NIBBLE(i) (uint8_t)(MS8607_crc4_shift((i) << 12, 4) >> 12)
+
+#define MS8607_TABLE4(f, i) f(i), f(i + 1), f(i + 2), f(i + 3)
+#define MS8607_TABLE16(f, i) MS8607_TABLE4(f, i), MS8607_TABLE4(f, i + 4), \
+                             MS8607_TABLE4(f, i + 8), MS8607_TABLE4(f, i + 12)
+#define MS8607_TABLE64(f, i) MS8607_TABLE16(f, i), MS8607_TABLE16(f, i + 16), \
+                             MS8607_TABLE16(f, i + 32), MS8607_TABLE16(f, i + 48)
+#define MS8607_TABLE256(f) MS8607_TABLE64(f, 0), MS8607_TABLE64(f, 64), \
+                           MS8607_TABLE64(f, 128), MS8607_TABLE64(f, 192)
+
+static_assert(MS8607_crc8_shift(0x80, 1) == 0x31, "CRC-8 polynomial");
+static_assert((MS8607_crc4_shift(0x8000, 8) & 0x0FFF) == 0 &&
+                  (MS8607_crc4_shift(0x0100, 8) & 0x0FFF) == 0,
+              "CRC-4 byte shift must only leave the top nibble");
+
+static const uint8_t crc8_byte_table[256] PROGMEM = {MS8607_TABLE256(MS8607_CRC8_BYTE)};
+static const uint8_t crc8_nibble_table[16] PROGMEM = {MS8607_TABLE16(MS8607_CRC8_NIBBLE, 0)};
+static const uint8_t crc4_byte_table[256] PROGMEM = {MS8607_TABLE256(MS8607_CRC4_BYTE)};
+static const uint8_t crc4_nibble_table[16] PROGMEM = {MS8607_TABLE16(MS8607_CRC4_NIBBLE, 0)};
+
+uint8_t MS8607_crc8(const uint8_t *data, uint8_t length)
+{
+  uint8_t crc = 0;
+
+  while (length--)
+    crc = pgm_read_byte(&crc8_byte_table[crc ^ *data++]);
+  return crc;
+}
+
+uint8_t MS8607_crc8_nibble(const uint8_t *data, uint8_t length)
+{
+  uint8_t crc = 0;
+
+  while (length--)
+  {
+    crc ^= *data++;
+    crc = (uint8_t)(crc << 4) ^ pgm_read_byte(&crc8_nibble_table[crc >> 4]);
+    crc = (uint8_t)(crc << 4) ^ pgm_read_byte(&crc8_nibble_table[crc >> 4]);
+  }
+  return crc;
+}
+
+uint8_t MS8607_crc4(const uint16_t *prom)
+{
+  uint16_t rem = 0;
+  uint16_t word;
+  uint8_t i;
+
+  // Words 0 to 6, the CRC nibble of word 0 cleared
+  for (i = 0; i < 7; i++)
+  {
+    word = (i == 0) ? (prom[0] & 0x0FFF) : prom[i];
+    rem ^= word >> 8;
+    rem = (uint16_t)(rem << 8) ^ ((uint16_t)pgm_read_byte(&crc4_byte_table[rem >> 8]) << 12);
+    rem ^= word & 0xFF;
+    rem = (uint16_t)(rem << 8) ^ ((uint16_t)pgm_read_byte(&crc4_byte_table[rem >> 8]) << 12);
+  }
+  // Word 7 is 0
+  for (i = 0; i < 2; i++)
+    rem = (uint16_t)(rem << 8) ^ ((uint16_t)pgm_read_byte(&crc4_byte_table[rem >> 8]) << 12);
+
+  return rem >> 12;
+}
+
+uint8_t MS8607_crc4_nibble(const uint16_t *prom)
+{
+  uint16_t rem = 0;
+  uint16_t word;
+  uint8_t i, n;
+
+  // Words 0 to 6, the CRC nibble of word 0 cleared, then word 7 = 0
+  for (i = 0; i < 8; i++)
+  {
+    word = (i == 0) ? (prom[0] & 0x0FFF) : (i < 7) ? prom[i] : 0;
+    rem ^= word >> 8;
+    for (n = 0; n < 2; n++)
+      rem = (uint16_t)(rem << 4) ^ ((uint16_t)pgm_read_byte(&crc4_nibble_table[rem >> 12]) << 12);
+    rem ^= word & 0xFF;
+    for (n = 0; n < 2; n++)
+      rem = (uint16_t)(rem << 4) ^ ((uint16_t)pgm_read_byte(&crc4_nibble_table[rem >> 12]) << 12);
+  }
+
+  return rem >> 12;
+}
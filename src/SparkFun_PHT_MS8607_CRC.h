@@ -0,0 +1,102 @@
+/*
+  Table driven CRC kernels for the MS8607.
+
+  The humidity die protects every reading and the serial number with a CRC-8
+  (polynomial x^8 + x^5 + x^4 + 1, initial value 0). The pressure die
+  protects its PROM with the 4-bit CRC of TE application note AN520.
+
+  Both CRCs are linear, so shifting a whole byte (or nibble) through the
+  register is the bit loop applied to the top bits only, and the result can
+  be looked up. The tables are generated at compile time from the bit loops
+  below and kept in flash (PROGMEM):
+    - byte tables : 256 entries each, one lookup per byte
+    - nibble tables : 16 entries each, two lookups per byte
+  None of the functions modify their input.
+
+  MIT License, see SparkFun_PHT_MS8607_Arduino_Library.h
+*/
+
+#ifndef MS8607_CRC_H
+#define MS8607_CRC_H
+
+#include <stdint.h>
+
+// Uncomment, or define for the whole build (e.g. -DMS8607_CRC_NIBBLE_TABLES),
+// to make the driver use the nibble tables (32 bytes of flash) instead of the
+// byte tables (512 bytes of flash). The byte tables are about twice as fast.
+//#define MS8607_CRC_NIBBLE_TABLES
+
+/*
+  \brief Shift a CRC-8 register by a number of bits (compile time).
+
+  \param[in] uint8_t : CRC register
+  \param[in] uint8_t : number of bits to shift
+
+  \return uint8_t : CRC register after the shifts
+*/
+constexpr uint8_t MS8607_crc8_shift(uint8_t crc, uint8_t bits)
+{
+  return (bits == 0) ? crc
+                     : MS8607_crc8_shift((crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31)
+                                                      : (uint8_t)(crc << 1),
+                                         bits - 1);
+}
+
+/*
+  \brief Shift the PROM CRC-4 register by a number of bits (compile time).
+
+  \param[in] uint16_t : CRC register
+  \param[in] uint8_t : number of bits to shift
+
+  \return uint16_t : CRC register after the shifts
+*/
+constexpr uint16_t MS8607_crc4_shift(uint16_t rem, uint8_t bits)
+{
+  return (bits == 0) ? rem
+                     : MS8607_crc4_shift((rem & 0x8000) ? (uint16_t)((rem << 1) ^ 0x3000)
+                                                        : (uint16_t)(rem << 1),
+                                         bits - 1);
+}
+
+/*
+  \brief CRC-8 of the humidity die, byte table.
+
+  \param[in] const uint8_t* : data
+  \param[in] uint8_t : number of bytes
+
+  \return uint8_t : CRC
+*/
+uint8_t MS8607_crc8(const uint8_t *data, uint8_t length);
+
+/*
+  \brief CRC-8 of the humidity die, nibble table.
+
+  \param[in] const uint8_t* : data
+  \param[in] uint8_t : number of bytes
+
+  \return uint8_t : CRC
+*/
+uint8_t MS8607_crc8_nibble(const uint8_t *data, uint8_t length);
+
+/*
+  \brief CRC-4 of the pressure die PROM, byte table.
+
+  The CRC nibble in the top of word 0 is ignored and word 7 is taken as 0,
+  as in AN520.
+
+  \param[in] const uint16_t* : PROM words 0 to 6
+
+  \return uint8_t : CRC, to compare with the top nibble of word 0
+*/
+uint8_t MS8607_crc4(const uint16_t *prom);
+
+/*
+  \brief CRC-4 of the pressure die PROM, nibble table.
+
+  \param[in] const uint16_t* : PROM words 0 to 6
+
+  \return uint8_t : CRC, to compare with the top nibble of word 0
+*/
+uint8_t MS8607_crc4_nibble(const uint16_t *prom);
+
+#endif
@@ -0,0 +1,164 @@
+#include "SparkFun_PHT_MS8607_Compensation.h"
+
+// PROM words holding the calibration coefficients C1 to C6
+#define COEFF_SENS_T1 1 // C1 Pressure sensitivity
+#define COEFF_OFF_T1 2  // C2 Pressure offset
+#define COEFF_TCS 3     // C3 Temperature coefficient of pressure sensitivity
+#define COEFF_TCO 4     // C4 Temperature coefficient of pressure offset
+#define COEFF_T_REF 5   // C5 Reference temperature
+#define COEFF_TEMPSENS 6 // C6 Temperature coefficient of the temperature
+
+// The helpers below work modulo 2^64 like int64_t, so the signs take care of
+// themselves. Words are added as unsigned values to keep the carries defined.
+
+static struct MS8607_wide wide_mul_u32(uint32_t a, uint32_t b)
+{
+  struct MS8607_wide r;
+  uint16_t al = a, ah = a >> 16, bl = b, bh = b >> 16;
+  uint32_t ll = (uint32_t)al * bl;
+  uint32_t lh = (uint32_t)al * bh;
+  uint32_t hl = (uint32_t)ah * bl;
+  uint32_t hh = (uint32_t)ah * bh;
+  uint32_t mid = (ll >> 16) + (lh & 0xFFFF) + (hl & 0xFFFF);
+
+  r.lo = (mid << 16) | (ll & 0xFFFF);
+  r.hi = hh + (lh >> 16) + (hl >> 16) + (mid >> 16);
+  return r;
+}
+
+static struct MS8607_wide wide_neg(struct MS8607_wide a)
+{
+  a.lo = 0 - a.lo;
+  a.hi = ~(uint32_t)a.hi + (a.lo == 0);
+  return a;
+}
+
+// a * b for a signed a
+static struct MS8607_wide wide_mul_i32(int32_t a, uint32_t b)
+{
+  if (a < 0)
+    return wide_neg(wide_mul_u32(0 - (uint32_t)a, b));
+  return wide_mul_u32(a, b);
+}
+
+// a * b for a 64-bit a
+static struct MS8607_wide wide_mul(struct MS8607_wide a, uint32_t b)
+{
+  struct MS8607_wide r = wide_mul_u32(a.lo, b);
+
+  r.hi = (uint32_t)r.hi + (uint32_t)a.hi * b;
+  return r;
+}
+
+static struct MS8607_wide wide_add(struct MS8607_wide a, struct MS8607_wide b)
+{
+  struct MS8607_wide r;
+
+  r.lo = a.lo + b.lo;
+  r.hi = (uint32_t)a.hi + (uint32_t)b.hi + (r.lo < a.lo);
+  return r;
+}
+
+static struct MS8607_wide wide_sub(struct MS8607_wide a, struct MS8607_wide b)
+{
+  struct MS8607_wide r;
+
+  r.lo = a.lo - b.lo;
+  r.hi = (uint32_t)a.hi - (uint32_t)b.hi - (a.lo < b.lo);
+  return r;
+}
+
+// a << n, 0 < n < 32
+static struct MS8607_wide wide_shl(struct MS8607_wide a, uint8_t n)
+{
+  a.hi = ((uint32_t)a.hi << n) | (a.lo >> (32 - n));
+  a.lo <<= n;
+  return a;
+}
+
+// a >> n (arithmetic, rounds down), 0 < n < 32
+static struct MS8607_wide wide_sar(struct MS8607_wide a, uint8_t n)
+{
+  a.lo = (a.lo >> n) | ((uint32_t)a.hi << (32 - n));
+  a.hi >>= n;
+  return a;
+}
+
+// x * x for a signed x
+static struct MS8607_wide wide_square(int32_t x)
+{
+  uint32_t u = (x < 0) ? 0 - (uint32_t)x : (uint32_t)x;
+  return wide_mul_u32(u, u);
+}
+
+void MS8607_compensate_temperature(const uint16_t *coeff, uint32_t adc_temperature,
+                                   struct MS8607_temperature_terms *terms)
+{
+  int32_t dT, TEMP, T2;
+  struct MS8607_wide OFF, SENS, OFF2, SENS2, dT2;
+
+  // Difference between actual and reference temperature = D2 - Tref
+  dT = (int32_t)adc_temperature - ((int32_t)coeff[COEFF_T_REF] << 8);
+
+  // Actual temperature = 2000 + dT * TEMPSENS
+  TEMP = 2000 + (int32_t)wide_sar(wide_mul_i32(dT, coeff[COEFF_TEMPSENS]), 23).lo;
+
+  // Second order temperature compensation
+  dT2 = wide_square(dT);
+  if (TEMP < 2000)
+  {
+    // T2 = 3 * dT^2 >> 33, OFF2 = 61 * (TEMP - 2000)^2 / 16,
+    // SENS2 = 29 * (TEMP - 2000)^2 / 16
+    T2 = wide_mul(dT2, 3).hi >> 1;
+    struct MS8607_wide t2 = wide_square(TEMP - 2000);
+    OFF2 = wide_sar(wide_mul(t2, 61), 4);
+    SENS2 = wide_sar(wide_mul(t2, 29), 4);
+
+    if (TEMP < -1500)
+    {
+      // OFF2 += 17 * (TEMP + 1500)^2, SENS2 += 9 * (TEMP + 1500)^2
+      t2 = wide_square(TEMP + 1500);
+      OFF2 = wide_add(OFF2, wide_mul(t2, 17));
+      SENS2 = wide_add(SENS2, wide_mul(t2, 9));
+    }
+  }
+  else
+  {
+    // T2 = 5 * dT^2 >> 38
+    T2 = wide_mul(dT2, 5).hi >> 6;
+    OFF2.hi = OFF2.lo = 0;
+    SENS2.hi = SENS2.lo = 0;
+  }
+
+  // OFF = OFF_T1 * 2^17 + TCO * dT / 2^6
+  OFF.hi = coeff[COEFF_OFF_T1] >> 15;
+  OFF.lo = (uint32_t)coeff[COEFF_OFF_T1] << 17;
+  OFF = wide_add(OFF, wide_sar(wide_mul_i32(dT, coeff[COEFF_TCO]), 6));
+  OFF = wide_sub(OFF, OFF2);
+
+  // Sensitivity at actual temperature = SENS_T1 * 2^16 + TCS * dT / 2^7
+  SENS.hi = 0;
+  SENS.lo = (uint32_t)coeff[COEFF_SENS_T1] << 16;
+  SENS = wide_add(SENS, wide_sar(wide_mul_i32(dT, coeff[COEFF_TCS]), 7));
+  SENS = wide_sub(SENS, SENS2);
+
+  terms->temperature = TEMP - T2;
+  terms->off = OFF;
+  terms->sens = SENS;
+}
+
+int32_t MS8607_compensate_pressure(const struct MS8607_temperature_terms *terms,
+                                   uint32_t adc_pressure)
+{
+  // P = ((D1 * SENS / 2^21) - OFF) / 2^15, rounding down at each step, is
+  // (D1 * SENS - OFF * 2^21) / 2^36 rounded down: the top word shifted by 4
+  struct MS8607_wide P = wide_sub(wide_mul(terms->sens, adc_pressure),
+                                  wide_shl(terms->off, 21));
+  return P.hi >> 4;
+}
+
+int32_t MS8607_compensate_humidity(uint16_t adc_humidity)
+{
+  // RH = -6 + 125 * adc / 2^16, rounded to the nearest 0.01 %RH
+  return (int32_t)(((uint32_t)adc_humidity * 12500 + 0x8000) >> 16) - 600;
+}
@@ -0,0 +1,94 @@
+/*
+  Integer compensation for the MS8607.
+
+  Converts the raw ADC values to temperature in 0.01 degC, pressure in Pa
+  (0.01 mbar) and relative humidity in 0.01 %RH with the second order
+  algorithm of the MS8607 datasheet. The result is bit-exact with the
+  datasheet's 64-bit reference code, but only 32-bit arithmetic is used: the
+  64-bit intermediate values (OFF, SENS and D1 * SENS) are kept as two 32-bit
+  words and every product is built from 16 x 16 bit multiplies. There is no
+  floating point, so a sketch that only uses this module and the integer API
+  of the driver does not link the soft-float library.
+
+  MIT License, see SparkFun_PHT_MS8607_Arduino_Library.h
+*/
+
+#ifndef MS8607_COMPENSATION_H
+#define MS8607_COMPENSATION_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// A 64-bit two's complement value as two 32-bit words: hi * 2^32 + lo
+struct MS8607_wide
+{
+       int32_t hi;
+       uint32_t lo;
+};
+
+// The temperature dependent terms of the pressure compensation. They only
+// change with D2, so they can be reused for several D1 conversions.
+struct MS8607_temperature_terms
+{
+       int32_t temperature;     // TEMP - T2 (0.01 degC)
+       struct MS8607_wide off;  // OFF - OFF2
+       struct MS8607_wide sens; // SENS - SENS2
+};
+
+/*
+  \brief Compute the temperature and the pressure offset and sensitivity
+         from a D2 ADC value.
+
+  \param[in] const uint16_t* : PROM words 0 to 6 (C1 to C6 in words 1 to 6)
+  \param[in] uint32_t : D2 temperature ADC value
+  \param[out] MS8607_temperature_terms* : Temperature and pressure terms
+*/
+void MS8607_compensate_temperature(const uint16_t *coeff, uint32_t adc_temperature,
+                                   struct MS8607_temperature_terms *terms);
+
+/*
+  \brief Compute the pressure from a D1 ADC value.
+
+  \param[in] const MS8607_temperature_terms* : Terms of the last D2 value
+  \param[in] uint32_t : D1 pressure ADC value
+
+  \return int32_t : Pressure in Pa (0.01 mbar)
+*/
+int32_t MS8607_compensate_pressure(const struct MS8607_temperature_terms *terms,
+                                   uint32_t adc_pressure);
+
+/*
+  \brief Convert a relative humidity ADC value.
+
+  \param[in] uint16_t : Relative humidity ADC value
+
+  \return int32_t : Relative humidity in 0.01 %RH, not temperature compensated
+*/
+int32_t MS8607_compensate_humidity(uint16_t adc_humidity);
+
+/*
+  \brief Compensate arrays of raw samples (structure of arrays), e.g. raw
+         logs processed on a host.
+
+         Gives the same results as the functions above, sample by sample.
+         The loops have no branches and no dependency between samples, so
+         the compiler can vectorize them (build with -O3 and e.g.
+         -march=native). They use 64-bit arithmetic and are meant for hosts,
+         not for the sensor node. A 0 ADC value (conversion not complete) is
+         not detected.
+
+  \param[in] const uint16_t* : PROM words 0 to 6 of the sensor
+  \param[in] const uint32_t* : D1 pressure ADC values
+  \param[in] const uint32_t* : D2 temperature ADC values
+  \param[in] const uint16_t* : Relative humidity ADC values (NULL to skip)
+  \param[out] int32_t* : Temperatures in 0.01 degC
+  \param[out] int32_t* : Pressures in Pa (0.01 mbar)
+  \param[out] int32_t* : Relative humidities in 0.01 %RH (NULL to skip)
+  \param[in] size_t : Number of samples
+*/
+void MS8607_compensate_batch(const uint16_t *coeff, const uint32_t *adc_pressure,
+                             const uint32_t *adc_temperature,
+                             const uint16_t *adc_humidity, int32_t *temperature,
+                             int32_t *pressure, int32_t *humidity, size_t count);
+
+#endif
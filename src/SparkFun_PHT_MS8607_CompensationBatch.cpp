@@ -0,0 +1,60 @@
+#include "SparkFun_PHT_MS8607_Compensation.h"
+
+// Batch versions of MS8607_compensate_temperature(), _pressure() and
+// _humidity(). The second order cases are selected with masks instead of
+// branches so that every sample runs the same instructions.
+
+static void compensate_pressure_batch(const uint16_t *coeff,
+                                      const uint32_t *__restrict__ adc_pressure,
+                                      const uint32_t *__restrict__ adc_temperature,
+                                      int32_t *__restrict__ temperature,
+                                      int32_t *__restrict__ pressure, size_t count)
+{
+  const int64_t t_ref = (int64_t)coeff[5] << 8;    // C5 * 2^8
+  const int64_t tempsens = coeff[6];               // C6
+  const int64_t off_t1 = (int64_t)coeff[2] << 17;  // C2 * 2^17
+  const int64_t tco = coeff[4];                    // C4
+  const int64_t sens_t1 = (int64_t)coeff[1] << 16; // C1 * 2^16
+  const int64_t tcs = coeff[3];                    // C3
+
+  for (size_t i = 0; i < count; i++)
+  {
+    int64_t dT = (int64_t)adc_temperature[i] - t_ref;
+    int64_t TEMP = 2000 + ((dT * tempsens) >> 23);
+
+    // All ones below 20C (-15C), 0 above
+    int64_t cold = -(int64_t)(TEMP < 2000);
+    int64_t very_cold = -(int64_t)(TEMP < -1500);
+
+    int64_t dT2 = dT * dT;
+    int64_t t20 = (TEMP - 2000) * (TEMP - 2000);
+    int64_t t15 = (TEMP + 1500) * (TEMP + 1500);
+    int64_t T2 = (cold & ((3 * dT2) >> 33)) | (~cold & ((5 * dT2) >> 38));
+    int64_t OFF2 = cold & (((61 * t20) >> 4) + (very_cold & (17 * t15)));
+    int64_t SENS2 = cold & (((29 * t20) >> 4) + (very_cold & (9 * t15)));
+
+    int64_t OFF = off_t1 + ((tco * dT) >> 6) - OFF2;
+    int64_t SENS = sens_t1 + ((tcs * dT) >> 7) - SENS2;
+
+    temperature[i] = (int32_t)(TEMP - T2);
+    pressure[i] = (int32_t)(((((int64_t)adc_pressure[i] * SENS) >> 21) - OFF) >> 15);
+  }
+}
+
+static void compensate_humidity_batch(const uint16_t *__restrict__ adc_humidity,
+                                      int32_t *__restrict__ humidity, size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+    humidity[i] = (int32_t)(((uint32_t)adc_humidity[i] * 12500 + 0x8000) >> 16) - 600;
+}
+
+void MS8607_compensate_batch(const uint16_t *coeff, const uint32_t *adc_pressure,
+                             const uint32_t *adc_temperature,
+                             const uint16_t *adc_humidity, int32_t *temperature,
+                             int32_t *pressure, int32_t *humidity, size_t count)
+{
+  compensate_pressure_batch(coeff, adc_pressure, adc_temperature, temperature,
+                            pressure, count);
+  if ((adc_humidity != NULL) && (humidity != NULL))
+    compensate_humidity_batch(adc_humidity, humidity, count);
+}
@@ -0,0 +1,401 @@
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "SparkFun_PHT_MS8607_FastMath.h"
+
+// Constants of the formulas: h = 44330 * (1 - (p / p0) ^ (1 / 5.255))
+#define ALTITUDE_SCALE 44330.0f
+#define ALTITUDE_EXPONENT 5.255f
+
+#define LN2_HIGH 0.693145751953125f // ln(2) in 16 bits, k * LN2_HIGH is exact
+#define LN2_LOW 1.42860682030941723212e-6f
+#define INV_LN2 1.44269504088896340736f
+#define INV_LN10 0.43429448190325182765f
+#define SQRT2 1.41421356237309504880f
+
+// Fixed point: Q30 (1.0 = 2^30) and Q27 for values up to 16
+#define Q30_ONE (1L << 30)
+#define LN2_Q30 744261118L      // ln(2)
+#define LN2_Q27 93032640L       // ln(2)
+#define INV_LN2_Q30 1549082005L // 1 / ln(2)
+#define EXPONENT_Q30 204327654L // 1 / 5.255
+#define EXPONENT_Q24 88164270L  // 5.255
+#define ALTITUDE_SCALE_CM 4433000L
+#define INV_ALTITUDE_SCALE_Q46 15873843L // 2^46 / 4433000
+#define MAX_EXP_Q27 (15L << 27)          // Largest y of exp(y), fits Q27
+#define MAX_EXPONENT_DIFFERENCE 20       // |ln(a / b)| < 15, fits Q27
+
+// Dew point: HSENSOR_CONSTANT_B and HSENSOR_CONSTANT_C of the driver. The
+// constant A cancels out of the formula.
+#define DEW_POINT_B 1762.39f
+#define DEW_POINT_C 235.66f
+#define DEW_POINT_B_CENTI 176239L // 0.01 degC
+#define DEW_POINT_C_CENTI 23566L
+#define DEW_POINT_MIN_TEMPERATURE -10000L // 0.01 degC, B / (T + C) < 14
+#define DEW_POINT_MAX_TEMPERATURE 100000L // (T + C) << 15 fits 32 bits
+#define LN_10000_Q30 9889527671LL         // ln(100%) in 0.01 %RH
+#define INV_LN10_Q30 466320149L           // 1 / ln(10)
+#define MIN_DEW_POINT_DENOMINATOR_Q26 (1L << 14) // Td + C fits 31 bits
+
+// 1 / c and ln(c) in Q30 for c = 1 + (i + 1/2) / 16, the centres of the 16
+// intervals of the mantissa. ln(c) is -ln() of the rounded 1 / c.
+#define LN_TABLE_BITS 4
+static const int32_t ln_inverse_table[1 << LN_TABLE_BITS] PROGMEM = {
+    1041204193L, 981706811L, 928641578L, 881018933L, 838042399L, 799063683L,
+    763549742L, 731058263L, 701219150L, 673720360L, 648296950L, 624722516L,
+    602802428L, 582368447L, 563274399L, 545392673L};
+static const int32_t ln_centre_table[1 << LN_TABLE_BITS] PROGMEM = {
+    33040817L, 96220322L, 155887995L, 212413774L, 266112055L, 317252283L,
+    366067135L, 412758919L, 457504636L, 500460037L, 541762892L, 581535654L,
+    619887652L, 656916903L, 692711612L, 727351447L};
+
+// ln(x), x > 0 and finite. Works on the IEEE 754 fields of the float.
+static float ln_fast(float x)
+{
+  uint32_t bits;
+  int exponent;
+  float m, t, t2;
+
+  memcpy(&bits, &x, sizeof(bits));
+  exponent = (int)((bits >> 23) & 0xFF) - 127;
+  bits = (bits & 0x007FFFFFUL) | 0x3F800000UL;
+  memcpy(&m, &bits, sizeof(m));
+
+  // m in [sqrt(1/2), sqrt(2)), so |t| <= 0.172
+  if (m >= SQRT2)
+  {
+    m *= 0.5f;
+    exponent++;
+  }
+  t = (m - 1.0f) / (m + 1.0f);
+  t2 = t * t;
+
+  // ln(m) = 2 atanh(t)
+  return exponent * LN2_HIGH +
+         (2.0f * t * (1.0f + t2 * (1.0f / 3 + t2 * (1.0f / 5 + t2 * (1.0f / 7 + t2 * (1.0f / 9))))) +
+          exponent * LN2_LOW);
+}
+
+// 2^k
+static float pow2_fast(int k)
+{
+  uint32_t bits;
+  float result;
+
+  if (k > 127)
+    return INFINITY;
+  if (k < -126)
+    return 0;
+  bits = (uint32_t)(k + 127) << 23;
+  memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+// exp(y) - 1 = 2^k * (1 + fraction) - 1, returns the fraction
+static float expm1_reduce(float y, int *k)
+{
+  float f, scaled = y * INV_LN2;
+
+  *k = (int)(scaled + ((scaled < 0) ? -0.5f : 0.5f));
+  f = (y - *k * LN2_HIGH) - *k * LN2_LOW;
+
+  // exp(f) - 1, |f| <= 0.347
+  return f * (1.0f + f * (1.0f / 2 + f * (1.0f / 6 + f * (1.0f / 24 + f * (1.0f / 120 + f * (1.0f / 720 + f * (1.0f / 5040)))))));
+}
+
+static float expm1_fast(float y)
+{
+  int k;
+  float fraction = expm1_reduce(y, &k);
+
+  if (k == 0)
+    return fraction;
+  return pow2_fast(k) * (1.0f + fraction) - 1.0f;
+}
+
+static float exp_fast(float y)
+{
+  int k;
+  float fraction = expm1_reduce(y, &k);
+
+  return pow2_fast(k) * (1.0f + fraction);
+}
+
+float MS8607_altitude_change_fast(float pressure, float baseline)
+{
+  if ((pressure <= 0) || (baseline <= 0))
+    return NAN;
+  return 0.0f - ALTITUDE_SCALE * expm1_fast(ln_fast(pressure / baseline) * (1.0f / ALTITUDE_EXPONENT));
+}
+
+float MS8607_sea_level_pressure_fast(float pressure, float altitude)
+{
+  float x = 1.0f - altitude * (1.0f / ALTITUDE_SCALE);
+
+  if (x <= 0)
+    return NAN;
+  return pressure * exp_fast(-ALTITUDE_EXPONENT * ln_fast(x));
+}
+
+void MS8607_altitude_change_fast_batch(const float *pressure, float baseline,
+                                       float *altitude, size_t count)
+{
+  float inverse = 1.0f / baseline;
+  size_t i;
+
+  for (i = 0; i < count; i++)
+  {
+    if ((pressure[i] <= 0) || (baseline <= 0))
+      altitude[i] = NAN;
+    else
+      altitude[i] = 0.0f - ALTITUDE_SCALE * expm1_fast(ln_fast(pressure[i] * inverse) * (1.0f / ALTITUDE_EXPONENT));
+  }
+}
+
+void MS8607_sea_level_pressure_fast_batch(const float *pressure,
+                                          const float *altitude,
+                                          float *sea_level, size_t count)
+{
+  size_t i;
+
+  for (i = 0; i < count; i++)
+    sea_level[i] = MS8607_sea_level_pressure_fast(pressure[i], altitude[i]);
+}
+
+/*
+  get_dew_point() computes the saturation pressure at T, multiplies it by the
+  relative humidity and inverts the saturation pressure formula:
+    Td = -B / (log10(RH / 100 * 10^(A - B / (T + C))) - A) - C
+  log10() of the product is log10(RH / 100) + A - B / (T + C), A cancels and
+  no pow() is left:
+    Td = B / (B / (T + C) - log10(RH / 100)) - C
+*/
+float MS8607_dew_point_fast(float temperature, float humidity)
+{
+  float denominator;
+
+  if (humidity <= 0)
+    return (humidity == 0) ? -DEW_POINT_C : NAN;
+
+  denominator = DEW_POINT_B / (temperature + DEW_POINT_C) -
+                ln_fast(humidity * 0.01f) * INV_LN10;
+  return DEW_POINT_B / denominator - DEW_POINT_C;
+}
+
+void MS8607_dew_point_fast_batch(const float *temperature, const float *humidity,
+                                 float *dew_point, size_t count)
+{
+  size_t i;
+
+  for (i = 0; i < count; i++)
+    dew_point[i] = MS8607_dew_point_fast(temperature[i], humidity[i]);
+}
+
+// a * b, both Q30, rounded
+static int32_t mul_q30(int32_t a, int32_t b)
+{
+  return (int32_t)(((int64_t)a * b + (1L << 29)) >> 30);
+}
+
+// value * 2^-shift, rounded to the nearest, shift can be negative
+static int64_t scale_shift(int64_t value, int8_t shift)
+{
+  if (shift <= 0)
+    return value << -shift;
+  return (value + ((int64_t)1 << (shift - 1))) >> shift;
+}
+
+// ln(m) in Q30 for x = m * 2^exponent, m in [1, 2), x > 0. No division: the
+// table brings m close to 1, then 5 terms of the series of ln(1 + r).
+static int32_t ln_fixed(uint32_t x, int8_t *exponent)
+{
+  int32_t r, series;
+  uint8_t i;
+
+  // m in Q30
+  *exponent = 30;
+  while (x < (1UL << 22))
+  {
+    x <<= 8;
+    *exponent -= 8;
+  }
+  while (x < (uint32_t)Q30_ONE)
+  {
+    x <<= 1;
+    (*exponent)--;
+  }
+  while (x >= 2 * (uint32_t)Q30_ONE)
+  {
+    x = (x >> 1) + (x & 1);
+    (*exponent)++;
+  }
+
+  // m / c - 1, |r| <= 1/32
+  i = (uint8_t)((x >> (30 - LN_TABLE_BITS)) & ((1 << LN_TABLE_BITS) - 1));
+  r = mul_q30((int32_t)x, (int32_t)pgm_read_dword(&ln_inverse_table[i])) - Q30_ONE;
+
+  series = -Q30_ONE / 4 + mul_q30(r, Q30_ONE / 5);
+  series = Q30_ONE / 3 + mul_q30(r, series);
+  series = -Q30_ONE / 2 + mul_q30(r, series);
+  series = Q30_ONE + mul_q30(r, series);
+
+  return (int32_t)pgm_read_dword(&ln_centre_table[i]) + mul_q30(r, series);
+}
+
+// ln(a / b) in Q27 from ln_fixed() of a and b
+static int32_t ln_ratio_fixed(int32_t ln_a, int8_t exponent_a, int32_t ln_b, int8_t exponent_b)
+{
+  return (exponent_a - exponent_b) * LN2_Q27 + (int32_t)scale_shift((int64_t)ln_a - ln_b, 3);
+}
+
+// exp(y) - 1 = 2^k * (1 + fraction) - 1, y in Q27 (|y| < 16), fraction in Q30
+static int32_t expm1_reduce_fixed(int32_t y, int8_t *k)
+{
+  int32_t f, series;
+
+  // k = round(y / ln(2))
+  *k = (int8_t)(((int64_t)y * INV_LN2_Q30 + (1LL << 56)) >> 57);
+  f = (y - *k * LN2_Q27) * 8; // Q30, |f| <= 0.347
+
+  series = Q30_ONE / 720 + mul_q30(f, Q30_ONE / 5040);
+  series = Q30_ONE / 120 + mul_q30(f, series);
+  series = Q30_ONE / 24 + mul_q30(f, series);
+  series = Q30_ONE / 6 + mul_q30(f, series);
+  series = Q30_ONE / 2 + mul_q30(f, series);
+  series = Q30_ONE + mul_q30(f, series);
+
+  return mul_q30(f, series);
+}
+
+// Altitude in cm for ln(pressure / baseline) in Q27
+static int32_t altitude_fixed(int32_t ln_ratio)
+{
+  int8_t k;
+  int32_t fraction = expm1_reduce_fixed(mul_q30(ln_ratio, EXPONENT_Q30), &k);
+  int64_t power_minus_one; // (pressure / baseline) ^ (1 / 5.255) - 1 in Q30
+
+  if (k == 0)
+    power_minus_one = fraction;
+  else
+    power_minus_one = scale_shift((int64_t)Q30_ONE + fraction, -k) - Q30_ONE;
+
+  return (int32_t)-scale_shift(power_minus_one * ALTITUDE_SCALE_CM, 30);
+}
+
+int32_t MS8607_altitude_change_fixed(int32_t pressure, int32_t baseline)
+{
+  int32_t ln_pressure, ln_baseline;
+  int8_t exponent_pressure, exponent_baseline;
+
+  if ((pressure <= 0) || (baseline <= 0))
+    return 0;
+
+  ln_pressure = ln_fixed(pressure, &exponent_pressure);
+  ln_baseline = ln_fixed(baseline, &exponent_baseline);
+  if (abs(exponent_pressure - exponent_baseline) > MAX_EXPONENT_DIFFERENCE)
+    return 0;
+  return altitude_fixed(ln_ratio_fixed(ln_pressure, exponent_pressure, ln_baseline, exponent_baseline));
+}
+
+int32_t MS8607_sea_level_pressure_fixed(int32_t pressure, int32_t altitude)
+{
+  int64_t x = Q30_ONE - scale_shift((int64_t)altitude * INV_ALTITUDE_SCALE_Q46, 16);
+  int32_t ln_x, fraction;
+  int64_t y, result;
+  int8_t exponent, k;
+
+  if ((pressure <= 0) || (x <= 0) || (x > 0xFFFFFFFFLL))
+    return 0;
+
+  // (1 - h / 44330) ^ -5.255 = exp(y), y in Q27
+  ln_x = ln_fixed((uint32_t)x, &exponent);
+  y = -scale_shift(((int64_t)(exponent - 30) * LN2_Q30 + ln_x) * EXPONENT_Q24, 27);
+  if (y > MAX_EXP_Q27)
+    return INT32_MAX;
+  fraction = expm1_reduce_fixed((int32_t)y, &k);
+
+  result = scale_shift((int64_t)pressure * (Q30_ONE + fraction), 30 - k);
+  if (result > INT32_MAX)
+    return INT32_MAX;
+  return (int32_t)result;
+}
+
+void MS8607_altitude_change_fixed_batch(const int32_t *pressure, int32_t baseline,
+                                        int32_t *altitude, size_t count)
+{
+  int32_t ln_pressure, ln_baseline = 0;
+  int8_t exponent_pressure, exponent_baseline = 0;
+  size_t i;
+
+  if (baseline > 0)
+    ln_baseline = ln_fixed(baseline, &exponent_baseline);
+
+  for (i = 0; i < count; i++)
+  {
+    if ((pressure[i] <= 0) || (baseline <= 0))
+      altitude[i] = 0;
+    else
+    {
+      ln_pressure = ln_fixed(pressure[i], &exponent_pressure);
+      if (abs(exponent_pressure - exponent_baseline) > MAX_EXPONENT_DIFFERENCE)
+        altitude[i] = 0;
+      else
+        altitude[i] = altitude_fixed(ln_ratio_fixed(ln_pressure, exponent_pressure, ln_baseline, exponent_baseline));
+    }
+  }
+}
+
+void MS8607_sea_level_pressure_fixed_batch(const int32_t *pressure,
+                                           const int32_t *altitude,
+                                           int32_t *sea_level, size_t count)
+{
+  size_t i;
+
+  for (i = 0; i < count; i++)
+    sea_level[i] = MS8607_sea_level_pressure_fixed(pressure[i], altitude[i]);
+}
+
+// Same formula as MS8607_dew_point_fast(), with 32 bit divisions only
+int32_t MS8607_dew_point_fixed(int32_t temperature, int32_t humidity)
+{
+  uint32_t sum, numerator, scaled;
+  int32_t ratio, ln_humidity, log_humidity;
+  int8_t exponent;
+
+  if ((temperature < DEW_POINT_MIN_TEMPERATURE) || (temperature > DEW_POINT_MAX_TEMPERATURE))
+    return INT32_MIN;
+  if (humidity <= 0)
+    return -DEW_POINT_C_CENTI;
+
+  // B / (T + C) in Q26, long division in two steps of 15 bits
+  sum = (uint32_t)(temperature + DEW_POINT_C_CENTI);
+  numerator = (uint32_t)DEW_POINT_B_CENTI << 11;
+  ratio = (int32_t)(((numerator / sum) << 15) + (((numerator % sum) << 15) + sum / 2) / sum);
+
+  // log10(RH / 100%) in Q26
+  ln_humidity = ln_fixed((uint32_t)humidity, &exponent);
+  log_humidity = mul_q30((int32_t)scale_shift((int64_t)exponent * LN2_Q30 + ln_humidity - LN_10000_Q30, 4),
+                         INV_LN10_Q30);
+  if (ratio - log_humidity < MIN_DEW_POINT_DENOMINATOR_Q26)
+    return INT32_MIN;
+
+  // B / (B / (T + C) - log10(RH / 100)) - C, the denominator in Q14
+  scaled = (uint32_t)(ratio - log_humidity + (1L << 11)) >> 12;
+  return (int32_t)((((uint32_t)DEW_POINT_B_CENTI << 14) + scaled / 2) / scaled) - DEW_POINT_C_CENTI;
+}
+
+void MS8607_dew_point_fixed_batch(const int32_t *temperature, const int32_t *humidity,
+                                  int32_t *dew_point, size_t count)
+{
+  size_t i;
+
+  for (i = 0; i < count; i++)
+    dew_point[i] = MS8607_dew_point_fixed(temperature[i], humidity[i]);
+}
@@ -0,0 +1,198 @@
+/*
+  Fast replacements for the pow() and log10() calls of the altitude and dew
+  point formulas.
+
+  altitudeChange() and adjustToSeaLevel() raise a pressure ratio to the
+  power 1/5.255 or 5.255 with pow() in double: a general purpose pow(), in
+  software double on Cortex-M0 and Cortex-M4F. Here x^a is exp(a * ln(x)),
+  specialised for these formulas:
+    - ln : the exponent of x taken out, then
+        float : the atanh series on the mantissa in [sqrt(1/2), sqrt(2))
+        fixed : a 16 entry table of 1/c and ln(c) brings the mantissa
+                within 1/32 of 1, then 5 terms of ln(1 + r), no division
+    - exp : k * ln(2) taken out, a degree 7 polynomial on the rest in
+      [-ln(2)/2, ln(2)/2], then 2^k put back in the exponent or as a shift
+  exp(y) - 1 is kept apart from the 1, so the altitude of a ratio close to 1
+  has no cancellation.
+
+  Two backends:
+    - float : the same units as the driver (mbar, m), no double
+    - fixed : int32_t only, pressures in Pa (0.01 mbar, as the _fixed API)
+      and altitudes in cm. Q30 arithmetic, 64 bit products.
+  and batch versions of each, for arrays of samples. The batch versions work
+  out the baseline part once.
+
+  Maximum error against pow() in double, for every pair of pressures from
+  10 to 1200mbar (the sensor range, altitudes up to 66km from the baseline)
+  and, for the sea level pressure, altitudes from -500m to 30km, measured
+  with extras/host/fastmath_benchmark.cpp:
+    - MS8607_altitude_change_fast : 1.5mm within 1km of the baseline, 1.9cm
+      at 66km. powf() in float: 3.9mm and 1.2cm.
+    - MS8607_sea_level_pressure_fast : 1.6e-6 of the result (powf() in
+      float: 0.9e-6), from the rounding of 1 - h / 44330 to a float
+    - MS8607_altitude_change_fixed : 0.6cm, the rounding to 1cm
+    - MS8607_sea_level_pressure_fixed : 0.5Pa, the rounding to 1Pa, plus
+      3e-7 of the result
+  Well below the noise of the sensor (about 13cm at OSR 8192).
+
+  The dew point formula of get_dew_point() simplifies to a single log10() of
+  the humidity (see SparkFun_PHT_MS8607_FastMath.cpp), computed with the same
+  ln. Maximum error against get_dew_point() in double, for every 0.01C from
+  -40 to 125C and every 0.01%RH from 0.01 to 100%RH:
+    - MS8607_dew_point_fast : 0.0001C (get_dew_point() in float: 0.0001C)
+    - MS8607_dew_point_fixed : 0.008C, 0.005C of it the rounding to 0.01C
+
+  MIT License, see SparkFun_PHT_MS8607_Arduino_Library.h
+*/
+
+#ifndef MS8607_FAST_MATH_H
+#define MS8607_FAST_MATH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Uncomment, or define for the whole build (e.g. -DMS8607_FAST_MATH), to make
+// altitudeChange(), adjustToSeaLevel() and get_dew_point() use the float
+// backend instead of pow() and log10() in double.
+//#define MS8607_FAST_MATH
+
+/*
+  \brief Altitude change for a change of pressure, as altitudeChange()
+
+  \param[in] float : Current pressure, mbar
+  \param[in] float : Pressure at the baseline, mbar (same unit as the current)
+
+  \return float : Altitude above the baseline, m. NAN if a pressure is not
+          positive.
+*/
+float MS8607_altitude_change_fast(float pressure, float baseline);
+
+/*
+  \brief Pressure at sea level, as adjustToSeaLevel()
+
+  \param[in] float : Absolute pressure, mbar
+  \param[in] float : Altitude, m (below 44330m)
+
+  \return float : Pressure at sea level, mbar. NAN if the altitude is 44330m
+          or more.
+*/
+float MS8607_sea_level_pressure_fast(float pressure, float altitude);
+
+/*
+  \brief MS8607_altitude_change_fast() on an array of pressures, with the
+         same baseline
+
+  \param[in] const float* : Pressures, mbar
+  \param[in] float : Pressure at the baseline, mbar
+  \param[out] float* : Altitudes, m (can be the array of pressures)
+  \param[in] size_t : Number of samples
+*/
+void MS8607_altitude_change_fast_batch(const float *pressure, float baseline,
+                                       float *altitude, size_t count);
+
+/*
+  \brief MS8607_sea_level_pressure_fast() on arrays of pressures and altitudes
+
+  \param[in] const float* : Absolute pressures, mbar
+  \param[in] const float* : Altitudes, m
+  \param[out] float* : Pressures at sea level, mbar (can be either input)
+  \param[in] size_t : Number of samples
+*/
+void MS8607_sea_level_pressure_fast_batch(const float *pressure,
+                                          const float *altitude,
+                                          float *sea_level, size_t count);
+
+/*
+  \brief Altitude change for a change of pressure, in integers
+
+  \param[in] int32_t : Current pressure, Pa
+  \param[in] int32_t : Pressure at the baseline, Pa
+
+  \return int32_t : Altitude above the baseline, cm. 0 if a pressure is not
+          positive, or one is more than a million times the other.
+*/
+int32_t MS8607_altitude_change_fixed(int32_t pressure, int32_t baseline);
+
+/*
+  \brief Pressure at sea level, in integers
+
+  \param[in] int32_t : Absolute pressure, Pa
+  \param[in] int32_t : Altitude, cm
+
+  \return int32_t : Pressure at sea level, Pa. 0 if the pressure is not
+          positive or the altitude not between -132990m and 44330m,
+          INT32_MAX if the result is too large.
+*/
+int32_t MS8607_sea_level_pressure_fixed(int32_t pressure, int32_t altitude);
+
+/*
+  \brief MS8607_altitude_change_fixed() on an array of pressures, with the
+         same baseline
+
+  \param[in] const int32_t* : Pressures, Pa
+  \param[in] int32_t : Pressure at the baseline, Pa
+  \param[out] int32_t* : Altitudes, cm (can be the array of pressures)
+  \param[in] size_t : Number of samples
+*/
+void MS8607_altitude_change_fixed_batch(const int32_t *pressure, int32_t baseline,
+                                        int32_t *altitude, size_t count);
+
+/*
+  \brief MS8607_sea_level_pressure_fixed() on arrays of pressures and
+         altitudes
+
+  \param[in] const int32_t* : Absolute pressures, Pa
+  \param[in] const int32_t* : Altitudes, cm
+  \param[out] int32_t* : Pressures at sea level, Pa (can be either input)
+  \param[in] size_t : Number of samples
+*/
+void MS8607_sea_level_pressure_fixed_batch(const int32_t *pressure,
+                                           const int32_t *altitude,
+                                           int32_t *sea_level, size_t count);
+
+/*
+  \brief Dew point, as get_dew_point(), without pow() or log10()
+
+  \param[in] float : Temperature, degC
+  \param[in] float : Relative humidity, %RH
+
+  \return float : Dew point, degC. -235.66 (the formula's limit) at 0%RH, NAN
+          below.
+*/
+float MS8607_dew_point_fast(float temperature, float humidity);
+
+/*
+  \brief MS8607_dew_point_fast() on arrays of temperatures and humidities
+
+  \param[in] const float* : Temperatures, degC
+  \param[in] const float* : Relative humidities, %RH
+  \param[out] float* : Dew points, degC (can be either input)
+  \param[in] size_t : Number of samples
+*/
+void MS8607_dew_point_fast_batch(const float *temperature, const float *humidity,
+                                 float *dew_point, size_t count);
+
+/*
+  \brief Dew point in integers, in the units of the _fixed API
+
+  \param[in] int32_t : Temperature, 0.01 degC (-100 to 1000 degC)
+  \param[in] int32_t : Relative humidity, 0.01 %RH
+
+  \return int32_t : Dew point, 0.01 degC. -23566 at 0%RH or below, INT32_MIN
+          if the temperature is out of range or the humidity so high that
+          there is no dew point.
+*/
+int32_t MS8607_dew_point_fixed(int32_t temperature, int32_t humidity);
+
+/*
+  \brief MS8607_dew_point_fixed() on arrays of temperatures and humidities
+
+  \param[in] const int32_t* : Temperatures, 0.01 degC
+  \param[in] const int32_t* : Relative humidities, 0.01 %RH
+  \param[out] int32_t* : Dew points, 0.01 degC (can be either input)
+  \param[in] size_t : Number of samples
+*/
+void MS8607_dew_point_fixed_batch(const int32_t *temperature, const int32_t *humidity,
+                                  int32_t *dew_point, size_t count);
+
+#endif
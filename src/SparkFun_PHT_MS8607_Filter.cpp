@@ -0,0 +1,152 @@
+#include "SparkFun_PHT_MS8607_Filter.h"
+
+// Fraction bits of the IIR state
+#define IIR_STATE_BITS 16
+#define IIR_MAX_SHIFT 16
+#define MAX_FRACTION_BITS 8
+
+// value * 2^fraction_bits / divider, rounded to the nearest (half up)
+static int32_t scale_round(int64_t value, uint32_t divider, uint8_t fraction_bits)
+{
+  int64_t quotient = value / (int64_t)divider;
+  int64_t remainder = value % (int64_t)divider;
+
+  // Round down, not towards 0
+  if (remainder < 0)
+  {
+    quotient--;
+    remainder += divider;
+  }
+
+  return (int32_t)(quotient * ((int64_t)1 << fraction_bits) +
+                   ((remainder << fraction_bits) + divider / 2) / divider);
+}
+
+bool MS8607_filter_init(struct MS8607_filter *filter, enum MS8607_filter_type type,
+                        uint16_t ratio, uint8_t order, uint8_t fraction_bits)
+{
+  uint64_t gain = 1;
+  uint8_t i;
+
+  if ((ratio == 0) || (fraction_bits > MAX_FRACTION_BITS))
+    return false;
+
+  switch (type)
+  {
+  case MS8607_filter_boxcar:
+    order = 1;
+    gain = ratio;
+    break;
+  case MS8607_filter_cic:
+    if ((order == 0) || (order > MS8607_FILTER_MAX_ORDER))
+      return false;
+    for (i = 0; i < order; i++)
+    {
+      gain *= ratio;
+      if (gain > 0x80000000UL)
+        return false;
+    }
+    break;
+  case MS8607_filter_iir:
+    if (order > IIR_MAX_SHIFT)
+      return false;
+    gain = 1UL << IIR_STATE_BITS;
+    break;
+  default:
+    return false;
+  }
+
+  filter->type = type;
+  filter->ratio = ratio;
+  filter->order = order;
+  filter->fraction_bits = fraction_bits;
+  filter->gain = gain;
+  MS8607_filter_reset(filter);
+
+  return true;
+}
+
+void MS8607_filter_reset(struct MS8607_filter *filter)
+{
+  uint8_t i;
+
+  for (i = 0; i < MS8607_FILTER_MAX_ORDER; i++)
+  {
+    filter->integrator[i] = 0;
+    filter->comb[i] = 0;
+  }
+  filter->count = 0;
+  if (filter->type == MS8607_filter_cic)
+    filter->warmup = filter->order - 1;
+  else if (filter->type == MS8607_filter_iir)
+    filter->warmup = 1;
+  else
+    filter->warmup = 0;
+}
+
+bool MS8607_filter_push(struct MS8607_filter *filter, int32_t sample,
+                        int32_t *output)
+{
+  uint64_t value;
+  uint8_t i;
+
+  if (filter->type == MS8607_filter_iir)
+  {
+    // State = y * 2^16, y += (x - y) / 2^shift
+    int64_t x = (int64_t)sample << IIR_STATE_BITS;
+    int64_t y = (int64_t)filter->integrator[0];
+
+    if (filter->warmup)
+    {
+      y = x;
+      filter->warmup = 0;
+    }
+    else
+      y += (x - y) >> filter->order;
+    filter->integrator[0] = (uint64_t)y;
+
+    if (++filter->count < filter->ratio)
+      return false;
+    filter->count = 0;
+
+    *output = scale_round(y, filter->gain, filter->fraction_bits);
+    return true;
+  }
+
+  // Integrators, modulo 2^64: the combs cancel the wrap-arounds
+  value = (uint64_t)(int64_t)sample;
+  for (i = 0; i < filter->order; i++)
+  {
+    filter->integrator[i] += value;
+    value = filter->integrator[i];
+  }
+
+  if (++filter->count < filter->ratio)
+    return false;
+  filter->count = 0;
+
+  if (filter->type == MS8607_filter_boxcar)
+  {
+    // The block sum, then start the next block
+    filter->integrator[0] = 0;
+  }
+  else
+  {
+    // Combs at the output rate, differential delay 1
+    for (i = 0; i < filter->order; i++)
+    {
+      uint64_t delayed = filter->comb[i];
+      filter->comb[i] = value;
+      value -= delayed;
+    }
+
+    if (filter->warmup)
+    {
+      filter->warmup--;
+      return false;
+    }
+  }
+
+  *output = scale_round((int64_t)value, filter->gain, filter->fraction_bits);
+  return true;
+}
@@ -0,0 +1,87 @@
+/*
+  Integer decimation filters for the MS8607.
+
+  Averaging N samples lowers the noise by about sqrt(N), like raising the
+  OSR, but a few fast conversions at a low OSR can be averaged in less time
+  and energy than one conversion at OSR 8192. These filters take integer
+  samples (raw ADC words, or the 0.01 degC / Pa / 0.01 %RH values of the
+  _fixed API), one at a time, and produce one output every ratio samples:
+    - boxcar : the mean of each block of ratio samples
+    - CIC : a cascade of order boxcars (integrators at the input rate, combs
+      at the output rate), with a sharper cut-off and a delay of about
+      order / 2 outputs. The first order - 1 outputs are not produced.
+    - IIR : y += (x - y) / 2^shift at the input rate, sampled every ratio
+      samples. The time constant is about 2^shift samples. It starts from
+      the first sample.
+  The state is a few 64-bit integers (at most MS8607_FILTER_MAX_ORDER
+  integrators and combs), there is no floating point, and only one division
+  per output. The outputs keep fraction_bits extra bits of resolution:
+  value = output / 2^fraction_bits, rounded to the nearest. The output must
+  fit in an int32_t: with 24-bit ADC words use at most 7 fraction bits.
+
+  MIT License, see SparkFun_PHT_MS8607_Arduino_Library.h
+*/
+
+#ifndef MS8607_FILTER_H
+#define MS8607_FILTER_H
+
+#include <stdint.h>
+
+#define MS8607_FILTER_MAX_ORDER 4
+
+enum MS8607_filter_type
+{
+       MS8607_filter_boxcar,
+       MS8607_filter_cic,
+       MS8607_filter_iir
+};
+
+struct MS8607_filter
+{
+       uint64_t integrator[MS8607_FILTER_MAX_ORDER]; // Sums (modulo 2^64), or the IIR state
+       uint64_t comb[MS8607_FILTER_MAX_ORDER];       // CIC comb delays
+       uint32_t gain;                                // Divider of the outputs
+       uint16_t ratio;                               // Samples per output
+       uint16_t count;                               // Samples since the last output
+       uint8_t type;                                 // MS8607_filter_type
+       uint8_t order;                                // CIC order, or the IIR shift
+       uint8_t fraction_bits;
+       uint8_t warmup;                               // Outputs still to drop (CIC), 1 before the first sample (IIR)
+};
+
+/*
+  \brief Set up a filter. Its state starts empty.
+
+  \param[out] MS8607_filter* : Filter
+  \param[in] MS8607_filter_type : boxcar, CIC or IIR
+  \param[in] uint16_t : Decimation ratio, samples per output (at least 1)
+  \param[in] uint8_t : CIC order (1 to MS8607_FILTER_MAX_ORDER), or the IIR
+         shift (0 to 16), ignored for the boxcar
+  \param[in] uint8_t : Extra bits of resolution of the outputs (0 to 8)
+
+  \return bool : false if a parameter is out of range, or the CIC gain
+         ratio^order is larger than 2^31
+*/
+bool MS8607_filter_init(struct MS8607_filter *filter, enum MS8607_filter_type type,
+                        uint16_t ratio, uint8_t order, uint8_t fraction_bits);
+
+/*
+  \brief Empty the filter, e.g. after a gap in the samples.
+
+  \param[in,out] MS8607_filter* : Filter
+*/
+void MS8607_filter_reset(struct MS8607_filter *filter);
+
+/*
+  \brief Add a sample.
+
+  \param[in,out] MS8607_filter* : Filter
+  \param[in] int32_t : Sample
+  \param[out] int32_t* : Output, in sample units * 2^fraction_bits
+
+  \return bool : true if an output was written
+*/
+bool MS8607_filter_push(struct MS8607_filter *filter, int32_t sample,
+                        int32_t *output);
+
+#endif
@@ -0,0 +1,394 @@
+/*
+  Several MS8607 on one I2C port, behind TCA9548A style multiplexers.
+
+  Both dies of the MS8607 have fixed addresses (0x40 and 0x76), so every
+  sensor needs a mux channel of its own. A TCA9548A (address 0x70 to 0x77)
+  has 8 channels and a one byte control register, one enable bit per
+  channel. 0x76 is the address of the pressure die, so up to 7 muxes share a
+  port, for up to 56 sensors. No MS8607 can sit on the port itself: it
+  would answer together with the sensor on the open channel.
+
+    - MS8607_MuxT<Bus> : the port, shared by all the sensors, and the
+      routing. It remembers which channel is on and only writes a control
+      register when a sensor on another channel is addressed: 1 write to
+      change channel on the same mux, 2 to change mux (the old mux off, then
+      the new channel on).
+    - MS8607_MuxBusT<Bus> : the bus policy of one sensor, its mux and
+      channel. MS8607T<MS8607_MuxBus> is a complete driver, with the PROM
+      coefficients and settings of its own device, that routes the port
+      before each of its transactions.
+    - MS8607_Manager<N, Bus> : N sensors with their locations, begin(),
+      settings for all of them and bulk reads.
+
+  Two kinds of bulk read:
+    - read_all() overlaps the conversions of the sensors. start_all() starts
+      an acquisition on every sensor, then each poll_all() does the next
+      step (ADC read, next conversion command) of the sensors whose
+      conversion is done, and leaves the others alone. The bus serves the
+      other sensors while one converts, so a sweep takes about one
+      acquisition (52ms at OSR 8192 and 12 bit RH) plus the bus time of the
+      N sensors, instead of N acquisitions. The routing follows the
+      deadlines: each step of each sensor can cost a mux switch, about 4 per
+      sensor per sweep (15 for 4 sensors on one mux). At 100kHz an
+      acquisition is 6 transactions and about 2.5ms of bus time with the mux
+      writes: around 20 sensors fill the bus.
+    - read_all_sequential() reads the sensors one after the other, in mux
+      and channel order, and alternates the direction, so a sweep starts on
+      the channel the previous one ended on: one control register write per
+      sensor (3 for 4 sensors on one mux, up to 2 more after a read_all()
+      that ended in the middle of the route), but N acquisitions. For mux setups where
+      switching is slow or disturbs the bus.
+
+  Bus is the policy of the port itself (MS8607_TwoWireBus by default, see
+  SparkFun_PHT_MS8607_Arduino_Library.h). MS8607_Mux and MS8607_MuxBus are
+  the Wire versions.
+
+  MIT License, see SparkFun_PHT_MS8607_Arduino_Library.h
+*/
+
+#ifndef MS8607_MANAGER_H
+#define MS8607_MANAGER_H
+
+#include "SparkFun_PHT_MS8607_Arduino_Library.h"
+
+#define MS8607_MUX_NONE 0xFF // No mux: the device is on the port itself
+#define MS8607_MUX_FIRST_ADDRESS 0x70
+#define MS8607_MUX_COUNT 8
+#define MS8607_MUX_CHANNELS 8
+
+template <class Bus>
+class MS8607_MuxT
+{
+public:
+       typedef typename Bus::port_type port_type;
+
+       MS8607_MuxT(void) : _muxes(0), _mux_address(MS8607_MUX_NONE), _channel(0), _known(false), _writes(0) {}
+
+       // Select the port, the routing is unknown until the next select()
+       void begin(port_type &port)
+       {
+              _bus.begin(port);
+              _known = false;
+       }
+
+       // Access the policy of the port, e.g. to set the clock
+       Bus &bus(void) { return _bus; }
+
+       // Declare a mux, so select() can turn it off when the routing is unknown
+       void add_mux(uint8_t mux_address);
+
+       /*
+   \brief Route the port to a channel of a mux, writing only the control
+          registers that change
+
+   \param[in] uint8_t : Mux address (0x70 to 0x77 except 0x76), or
+          MS8607_MUX_NONE for every mux off, e.g. for a device on the port
+          whose address is used behind a mux as well
+   \param[in] uint8_t : Channel, 0 to 7
+
+   \return uint8_t : i2c_status_code of the failed control write, or
+          i2c_status_ok
+  */
+       uint8_t select(uint8_t mux_address, uint8_t channel);
+
+       // Forget the routing, the next select() writes every control register
+       void invalidate(void) { _known = false; }
+
+       // Control register writes since begin
+       uint32_t get_switch_count(void) { return _writes; }
+
+       // Whether a sensor at this location is routed to the port now
+       bool is_selected(uint8_t mux_address, uint8_t channel)
+       {
+              return _known && (_mux_address == mux_address) &&
+                     ((mux_address == MS8607_MUX_NONE) || (_channel == channel));
+       }
+
+       // Free a stuck port. The muxes may have lost their state.
+       bool recover(void)
+       {
+              _known = false;
+              return _bus.recover();
+       }
+
+private:
+       uint8_t write_control(uint8_t mux_address, uint8_t value);
+
+       Bus _bus;
+       uint8_t _muxes;       // Bit i: a mux at MS8607_MUX_FIRST_ADDRESS + i
+       uint8_t _mux_address; // Mux with a channel on, MS8607_MUX_NONE for none
+       uint8_t _channel;     // The channel on
+       bool _known;          // false: the muxes may be in any state
+       uint32_t _writes;
+};
+
+template <class Bus>
+class MS8607_MuxBusT
+{
+public:
+       typedef MS8607_MuxT<Bus> port_type;
+
+       MS8607_MuxBusT(void) : _mux(NULL), _mux_address(MS8607_MUX_NONE), _channel(0) {}
+
+       void begin(port_type &mux)
+       {
+              _mux = &mux;
+              _mux->add_mux(_mux_address);
+       }
+
+       // Where the sensor is. Call before begin().
+       void set_location(uint8_t mux_address, uint8_t channel)
+       {
+              _mux_address = mux_address;
+              _channel = channel;
+       }
+
+       uint8_t mux_address(void) const { return _mux_address; }
+       uint8_t channel(void) const { return _channel; }
+
+       uint8_t write(uint8_t address, const uint8_t *data, uint8_t length)
+       {
+              if (_mux == NULL)
+                     return i2c_status_err_timeout;
+
+              uint8_t status = _mux->select(_mux_address, _channel);
+              if (status != i2c_status_ok)
+                     return status;
+              return _mux->bus().write(address, data, length);
+       }
+
+       uint8_t read(uint8_t address, uint8_t *data, uint8_t length)
+       {
+              if ((_mux == NULL) || (_mux->select(_mux_address, _channel) != i2c_status_ok))
+                     return 0;
+              return _mux->bus().read(address, data, length);
+       }
+
+       bool recover(void) { return (_mux != NULL) && _mux->recover(); }
+
+private:
+       port_type *_mux;
+       uint8_t _mux_address;
+       uint8_t _channel;
+};
+
+typedef MS8607_MuxT<MS8607_TwoWireBus> MS8607_Mux;
+typedef MS8607_MuxBusT<MS8607_TwoWireBus> MS8607_MuxBus;
+
+template <uint8_t N, class Bus = MS8607_TwoWireBus>
+class MS8607_Manager
+{
+       static_assert(N > 0, "N must be at least 1");
+       static_assert(N <= (MS8607_MUX_COUNT - 1) * MS8607_MUX_CHANNELS,
+                     "N must be at most 56, 8 channels on each of 7 muxes");
+
+public:
+       typedef MS8607T<MS8607_MuxBusT<Bus> > sensor_type;
+
+       MS8607_Manager(void);
+
+       /*
+   \brief Set where a sensor is. Call before begin(). By default sensor i
+          is on channel i % 8 of the (i / 8)th mux: 0x70, 0x71, ... 0x75,
+          0x77.
+
+   \param[in] uint8_t : Sensor index, 0 to N - 1
+   \param[in] uint8_t : Mux address, 0x70 to 0x77 except 0x76
+   \param[in] uint8_t : Mux channel, 0 to 7
+
+   \return bool : false if a parameter is out of range
+  */
+       bool set_location(uint8_t index, uint8_t mux_address, uint8_t channel);
+
+       /*
+   \brief Start every sensor: probe it, read its PROM coefficients (or take
+          them from its PROM cache, see sensor()) and set its defaults
+
+   \param[in] Bus::port_type& : Port of the muxes (e.g. Wire)
+
+   \return uint8_t : Number of sensors that answered, see isPresent()
+  */
+       uint8_t begin(typename Bus::port_type &port);
+
+       /*
+   \brief begin() on the port the policy already uses (Wire by default)
+  */
+       uint8_t begin(void);
+
+       /*
+   \brief Whether a sensor answered in begin()
+  */
+       bool isPresent(uint8_t index) { return (index < N) && _present[index]; }
+
+       /*
+   \brief The driver of one sensor, for per sensor settings and reads. The
+          port is routed to the sensor before each of its transactions.
+  */
+       sensor_type &sensor(uint8_t index) { return _sensors[index]; }
+
+       /*
+   \brief The port and routing shared by the sensors
+  */
+       MS8607_MuxT<Bus> &mux(void) { return _mux; }
+
+       /*
+   \brief Number of mux control register writes since begin()
+  */
+       uint32_t get_switch_count(void) { return _mux.get_switch_count(); }
+
+       // Settings of every present sensor, as the MS8607T functions
+       void set_pressure_resolution(enum MS8607_pressure_resolution res);
+       enum MS8607_status set_humidity_resolution(enum MS8607_humidity_resolution res);
+       void set_temperature_refresh(uint16_t samples, uint32_t interval = 0);
+       void set_acquisition_mode(enum MS8607_acquisition_mode mode);
+       void set_adaptive_timing(bool enable);
+
+       /******************** Overlapped acquisition ********************/
+
+       /*
+   \brief Start a non-blocking acquisition on every present sensor, see
+          MS8607T::startMeasurement(). Abandons the acquisitions in progress.
+
+   \param[in] uint8_t : MS8607_channel bits to acquire (default all)
+
+   \return uint8_t : Number of acquisitions started
+  */
+       uint8_t start_all(uint8_t channels = MS8607_channel_all);
+
+       /*
+   \brief Advance the acquisitions of the sensors whose conversion is done,
+          starting with the sensor the bus is routed to. The others cost no
+          bus transaction. Call it as often as you like.
+
+   \return uint8_t : Number of acquisitions still in progress
+  */
+       uint8_t poll_all(void);
+
+       /*
+   \brief Poll the acquisitions and check whether they are all finished
+
+   \return bool : true once getResults() returns every sensor
+  */
+       bool isReady(void);
+
+       /*
+   \brief Time until the next conversion of any sensor completes. Use it to
+          sleep between calls to poll_all().
+
+   \return uint32_t : microseconds, 0 if poll_all() has work to do now or
+          no acquisition is in progress
+  */
+       uint32_t getMicrosToNextStep(void);
+
+       /*
+   \brief Results of the last start_all()
+
+   \param[out] MS8607_sample_fixed* : N samples, indexed like the sensors.
+          The timestamp is when poll_all() saw the acquisition complete. The
+          channels of a sensor that is not present, failed or is not done
+          yet are 0.
+
+   \return uint8_t : Number of sensors with a result
+  */
+       uint8_t getResults_fixed(struct MS8607_sample_fixed *samples);
+
+       /*
+   \brief getResults_fixed() in float units
+
+   \param[out] MS8607_sample* : N samples, indexed like the sensors
+
+   \return uint8_t : Number of sensors with a result
+  */
+       uint8_t getResults(struct MS8607_sample *samples);
+
+       /******************** Blocking reads ********************/
+
+       /*
+   \brief Read every present sensor, the conversions overlapped:
+          start_all(), then poll_all() until every acquisition is finished,
+          sleeping in between, then getResults_fixed()
+
+   \param[out] MS8607_sample_fixed* : N samples, indexed like the sensors.
+          The channels of a sensor that is not present or failed are 0.
+   \param[in] uint8_t : MS8607_channel bits to acquire (default all)
+
+   \return uint8_t : Number of sensors read
+  */
+       uint8_t read_all_fixed(struct MS8607_sample_fixed *samples,
+                              uint8_t channels = MS8607_channel_all);
+
+       /*
+   \brief read_all_fixed() in float units
+
+   \param[out] MS8607_sample* : N samples, indexed like the sensors
+   \param[in] uint8_t : MS8607_channel bits to acquire (default all)
+
+   \return uint8_t : Number of sensors read
+  */
+       uint8_t read_all(struct MS8607_sample *samples,
+                        uint8_t channels = MS8607_channel_all);
+
+       /*
+   \brief Read every present sensor, one after the other, in the order
+          that needs the fewest mux switches (one per sensor). Slower than
+          read_all_fixed(), the conversions do not overlap.
+
+   \param[out] MS8607_sample_fixed* : N samples, indexed like the sensors.
+          The channels of a sensor that is not present or failed are 0.
+   \param[in] uint8_t : MS8607_channel bits to acquire (default all)
+
+   \return uint8_t : Number of sensors read
+  */
+       uint8_t read_all_sequential_fixed(struct MS8607_sample_fixed *samples,
+                                         uint8_t channels = MS8607_channel_all);
+
+       /*
+   \brief read_all_sequential_fixed() in float units
+
+   \param[out] MS8607_sample* : N samples, indexed like the sensors
+   \param[in] uint8_t : MS8607_channel bits to acquire (default all)
+
+   \return uint8_t : Number of sensors read
+  */
+       uint8_t read_all_sequential(struct MS8607_sample *samples,
+                                   uint8_t channels = MS8607_channel_all);
+
+       /*
+   \brief Sensor index in the sweep order, mux by mux and channel by channel
+
+   \param[in] uint8_t : Position in the sweep, 0 to N - 1
+  */
+       uint8_t route_order(uint8_t position) { return _order[position]; }
+
+private:
+       // Sort the sensors by mux address, then channel
+       void sort_route(void);
+
+       // Copy the result of one sensor into out, all zero if there is none
+       bool get_result(uint8_t index, struct MS8607_sample_fixed *out);
+
+       // Read one sensor with a blocking read, all zero if it is absent or fails
+       bool read_sensor(uint8_t index, uint8_t channels, struct MS8607_sample_fixed *out);
+
+       // Sleep until a conversion completes
+       void wait_next_step(void);
+
+       // Set the direction of the next sweep to start on the routed sensor,
+       // if it is at one end of the route
+       void sweep_from_route(void);
+
+       // Next position of the alternating sweep
+       uint8_t sweep_index(uint8_t step);
+
+       MS8607_MuxT<Bus> _mux;
+       sensor_type _sensors[N];
+       uint8_t _order[N];
+       bool _present[N];
+       bool _busy[N];          // Acquisition in progress
+       uint32_t _completed[N]; // millis() when poll_all() saw it finish
+       bool _reverse;          // Direction of the next sweep
+};
+
+#include "SparkFun_PHT_MS8607_Manager_impl.h"
+
+#endif
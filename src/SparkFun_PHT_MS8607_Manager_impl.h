@@ -0,0 +1,496 @@
+/*
+  Template definitions of MS8607_MuxT and MS8607_Manager, included at the end
+  of SparkFun_PHT_MS8607_Manager.h.
+
+  MIT License, see SparkFun_PHT_MS8607_Arduino_Library.h
+*/
+
+#ifndef MS8607_MANAGER_IMPL_H
+#define MS8607_MANAGER_IMPL_H
+
+/*
+  \brief Declare a mux on the port
+
+  \param[in] uint8_t : Mux address, 0x70 to 0x77 except 0x76. Other values
+         are ignored.
+*/
+template <class Bus>
+void MS8607_MuxT<Bus>::add_mux(uint8_t mux_address)
+{
+  uint8_t index = mux_address - MS8607_MUX_FIRST_ADDRESS;
+
+  if ((index < MS8607_MUX_COUNT) && (mux_address != MS8607_PSENSOR_ADDR))
+    _muxes |= (uint8_t)(1 << index);
+}
+
+template <class Bus>
+uint8_t MS8607_MuxT<Bus>::write_control(uint8_t mux_address, uint8_t value)
+{
+  _writes++;
+  return _bus.write(mux_address, &value, 1);
+}
+
+template <class Bus>
+uint8_t MS8607_MuxT<Bus>::select(uint8_t mux_address, uint8_t channel)
+{
+  uint8_t status = i2c_status_ok;
+
+  if (mux_address != MS8607_MUX_NONE)
+    channel &= MS8607_MUX_CHANNELS - 1;
+  if (is_selected(mux_address, channel))
+    return i2c_status_ok;
+
+  //Turn off the channel of any other mux. The same address would answer on
+  //two channels otherwise.
+  if (!_known)
+  {
+    for (uint8_t i = 0; i < MS8607_MUX_COUNT; i++)
+    {
+      uint8_t address = MS8607_MUX_FIRST_ADDRESS + i;
+      if ((_muxes & (1 << i)) && (address != mux_address))
+        status |= write_control(address, 0);
+    }
+  }
+  else if ((_mux_address != MS8607_MUX_NONE) && (_mux_address != mux_address))
+    status = write_control(_mux_address, 0);
+
+  if ((status == i2c_status_ok) && (mux_address != MS8607_MUX_NONE))
+    status = write_control(mux_address, (uint8_t)(1 << channel));
+
+  //After a failed write some mux may be in any state
+  _known = (status == i2c_status_ok);
+  _mux_address = mux_address;
+  _channel = channel;
+
+  return status;
+}
+
+template <uint8_t N, class Bus>
+MS8607_Manager<N, Bus>::MS8607_Manager(void) : _reverse(false)
+{
+  for (uint8_t i = 0; i < N; i++)
+  {
+    //0x70, 0x71, ... skipping 0x76, the address of the pressure die
+    uint8_t mux_address = MS8607_MUX_FIRST_ADDRESS + i / MS8607_MUX_CHANNELS;
+    if (mux_address >= MS8607_PSENSOR_ADDR)
+      mux_address++;
+    _sensors[i].bus().set_location(mux_address, i % MS8607_MUX_CHANNELS);
+    _present[i] = false;
+    _busy[i] = false;
+    _completed[i] = 0;
+  }
+  sort_route();
+}
+
+template <uint8_t N, class Bus>
+bool MS8607_Manager<N, Bus>::set_location(uint8_t index, uint8_t mux_address,
+                                          uint8_t channel)
+{
+  if ((index >= N) || (channel >= MS8607_MUX_CHANNELS))
+    return (false);
+  if (((uint8_t)(mux_address - MS8607_MUX_FIRST_ADDRESS) >= MS8607_MUX_COUNT) ||
+      (mux_address == MS8607_PSENSOR_ADDR))
+    return (false);
+
+  _sensors[index].bus().set_location(mux_address, channel);
+  sort_route();
+  return (true);
+}
+
+template <uint8_t N, class Bus>
+uint8_t MS8607_Manager<N, Bus>::begin(typename Bus::port_type &port)
+{
+  _mux.begin(port);
+  return begin();
+}
+
+template <uint8_t N, class Bus>
+uint8_t MS8607_Manager<N, Bus>::begin(void)
+{
+  uint8_t found = 0;
+
+  //Register every mux first, so the first select() turns them all off
+  for (uint8_t i = 0; i < N; i++)
+    _mux.add_mux(_sensors[i].bus().mux_address());
+  _mux.invalidate();
+
+  for (uint8_t step = 0; step < N; step++)
+  {
+    uint8_t i = _order[step];
+    _present[i] = _sensors[i].begin(_mux);
+    if (_present[i])
+      found++;
+  }
+  _reverse = true; //The route ends on the last sensor
+
+  return found;
+}
+
+template <uint8_t N, class Bus>
+void MS8607_Manager<N, Bus>::set_pressure_resolution(enum MS8607_pressure_resolution res)
+{
+  //No bus transaction, the OSR goes with each conversion command
+  for (uint8_t i = 0; i < N; i++)
+    _sensors[i].set_pressure_resolution(res);
+}
+
+/*
+  \brief Set the humidity resolution of every present sensor
+
+  \return MS8607_status : the first error, or MS8607_status_ok. The sensors
+          after a failed one are still set.
+*/
+template <uint8_t N, class Bus>
+enum MS8607_status MS8607_Manager<N, Bus>::set_humidity_resolution(enum MS8607_humidity_resolution res)
+{
+  enum MS8607_status result = MS8607_status_ok;
+
+  for (uint8_t step = 0; step < N; step++)
+  {
+    uint8_t i = sweep_index(step);
+    if (!_present[i])
+      continue;
+
+    enum MS8607_status status = _sensors[i].set_humidity_resolution(res);
+    if (result == MS8607_status_ok)
+      result = status;
+  }
+  _reverse = !_reverse;
+
+  return result;
+}
+
+template <uint8_t N, class Bus>
+void MS8607_Manager<N, Bus>::set_temperature_refresh(uint16_t samples, uint32_t interval)
+{
+  for (uint8_t i = 0; i < N; i++)
+    _sensors[i].set_temperature_refresh(samples, interval);
+}
+
+template <uint8_t N, class Bus>
+void MS8607_Manager<N, Bus>::set_acquisition_mode(enum MS8607_acquisition_mode mode)
+{
+  for (uint8_t i = 0; i < N; i++)
+    _sensors[i].set_acquisition_mode(mode);
+}
+
+template <uint8_t N, class Bus>
+void MS8607_Manager<N, Bus>::set_adaptive_timing(bool enable)
+{
+  for (uint8_t i = 0; i < N; i++)
+    _sensors[i].set_adaptive_timing(enable);
+}
+
+/******************** Overlapped acquisition ********************/
+
+template <uint8_t N, class Bus>
+uint8_t MS8607_Manager<N, Bus>::start_all(uint8_t channels)
+{
+  uint8_t started = 0;
+
+  for (uint8_t step = 0; step < N; step++)
+  {
+    uint8_t i = sweep_index(step);
+
+    _busy[i] = false;
+    _completed[i] = 0;
+    if (!_present[i])
+      continue;
+
+    //startMeasurement() also polls, a short acquisition can be done already
+    if (_sensors[i].startMeasurement(channels) == MS8607_status_ok)
+    {
+      _busy[i] = true;
+      started++;
+    }
+  }
+  _reverse = !_reverse;
+
+  poll_all();
+  return started;
+}
+
+template <uint8_t N, class Bus>
+uint8_t MS8607_Manager<N, Bus>::poll_all(void)
+{
+  uint8_t busy = 0;
+  uint8_t first = 0;
+
+  //Start with the sensor the bus is routed to, it needs no mux write
+  for (uint8_t step = 0; step < N; step++)
+  {
+    const MS8607_MuxBusT<Bus> &location = _sensors[_order[step]].bus();
+    if (_mux.is_selected(location.mux_address(), location.channel()))
+    {
+      first = step;
+      break;
+    }
+  }
+
+  for (uint8_t step = 0; step < N; step++)
+  {
+    uint8_t i = _order[(first + step) % N];
+    if (!_busy[i])
+      continue;
+
+    //A sensor still converting would only compare its deadline in poll()
+    if (_sensors[i].getMicrosToNextStep() == 0)
+      _sensors[i].poll();
+
+    enum MS8607_acquisition_state state = _sensors[i].getAcquisitionState();
+    if ((state == MS8607_acquisition_complete) || (state == MS8607_acquisition_error))
+    {
+      _busy[i] = false;
+      _completed[i] = millis();
+    }
+    else
+      busy++;
+  }
+
+  return busy;
+}
+
+template <uint8_t N, class Bus>
+bool MS8607_Manager<N, Bus>::isReady(void)
+{
+  return (poll_all() == 0);
+}
+
+template <uint8_t N, class Bus>
+uint32_t MS8607_Manager<N, Bus>::getMicrosToNextStep(void)
+{
+  uint32_t next = 0xFFFFFFFF;
+
+  for (uint8_t i = 0; i < N; i++)
+  {
+    if (!_busy[i])
+      continue;
+
+    uint32_t wait = _sensors[i].getMicrosToNextStep();
+    if (wait < next)
+      next = wait;
+  }
+
+  return (next == 0xFFFFFFFF) ? 0 : next;
+}
+
+template <uint8_t N, class Bus>
+uint8_t MS8607_Manager<N, Bus>::getResults_fixed(struct MS8607_sample_fixed *samples)
+{
+  uint8_t count = 0;
+
+  for (uint8_t i = 0; i < N; i++)
+  {
+    if (get_result(i, &samples[i]))
+      count++;
+  }
+
+  return count;
+}
+
+template <uint8_t N, class Bus>
+uint8_t MS8607_Manager<N, Bus>::getResults(struct MS8607_sample *samples)
+{
+  uint8_t count = 0;
+
+  for (uint8_t i = 0; i < N; i++)
+  {
+    struct MS8607_sample_fixed fixed;
+
+    if (get_result(i, &fixed))
+      count++;
+
+    samples[i].temperature = (float)fixed.temperature / 100;
+    samples[i].pressure = (float)fixed.pressure / 100;
+    samples[i].humidity = (float)fixed.humidity / 100;
+    samples[i].timestamp = fixed.timestamp;
+    samples[i].sequence = fixed.sequence;
+    samples[i].channels = fixed.channels;
+  }
+
+  return count;
+}
+
+/******************** Blocking reads ********************/
+
+template <uint8_t N, class Bus>
+uint8_t MS8607_Manager<N, Bus>::read_all_fixed(struct MS8607_sample_fixed *samples,
+                                               uint8_t channels)
+{
+  start_all(channels);
+  while (poll_all() != 0)
+    wait_next_step();
+
+  return getResults_fixed(samples);
+}
+
+template <uint8_t N, class Bus>
+uint8_t MS8607_Manager<N, Bus>::read_all(struct MS8607_sample *samples,
+                                         uint8_t channels)
+{
+  start_all(channels);
+  while (poll_all() != 0)
+    wait_next_step();
+
+  return getResults(samples);
+}
+
+template <uint8_t N, class Bus>
+uint8_t MS8607_Manager<N, Bus>::read_all_sequential_fixed(struct MS8607_sample_fixed *samples,
+                                                          uint8_t channels)
+{
+  uint8_t count = 0;
+
+  sweep_from_route();
+
+  for (uint8_t step = 0; step < N; step++)
+  {
+    uint8_t i = sweep_index(step);
+    if (read_sensor(i, channels, &samples[i]))
+      count++;
+  }
+  _reverse = !_reverse;
+
+  return count;
+}
+
+template <uint8_t N, class Bus>
+uint8_t MS8607_Manager<N, Bus>::read_all_sequential(struct MS8607_sample *samples,
+                                                    uint8_t channels)
+{
+  uint8_t count = 0;
+
+  sweep_from_route();
+
+  for (uint8_t step = 0; step < N; step++)
+  {
+    uint8_t i = sweep_index(step);
+    struct MS8607_sample_fixed fixed;
+
+    if (read_sensor(i, channels, &fixed))
+      count++;
+
+    samples[i].temperature = (float)fixed.temperature / 100;
+    samples[i].pressure = (float)fixed.pressure / 100;
+    samples[i].humidity = (float)fixed.humidity / 100;
+    samples[i].timestamp = fixed.timestamp;
+    samples[i].sequence = fixed.sequence;
+    samples[i].channels = fixed.channels;
+  }
+  _reverse = !_reverse;
+
+  return count;
+}
+
+template <uint8_t N, class Bus>
+bool MS8607_Manager<N, Bus>::read_sensor(uint8_t index, uint8_t channels,
+                                         struct MS8607_sample_fixed *out)
+{
+  out->temperature = 0;
+  out->pressure = 0;
+  out->humidity = 0;
+  out->timestamp = 0;
+  out->sequence = 0;
+  out->channels = 0;
+  _busy[index] = false; //A blocking read abandons the acquisition in progress
+  if (!_present[index])
+    return (false);
+
+  //Not getSample_fixed(), which can read the sensor again
+  channels &= MS8607_channel_all;
+  if (_sensors[index].read_temperature_pressure_humidity_fixed(&out->temperature, &out->pressure,
+                                                               &out->humidity, channels) != MS8607_status_ok)
+    return (false);
+
+  //The pressure is compensated with the temperature, so it comes with it
+  if (channels & MS8607_channel_pressure)
+    channels |= MS8607_channel_temperature;
+  out->timestamp = millis();
+  out->sequence = _sensors[index].getSampleSequence();
+  out->channels = channels;
+
+  return (true);
+}
+
+template <uint8_t N, class Bus>
+bool MS8607_Manager<N, Bus>::get_result(uint8_t index, struct MS8607_sample_fixed *out)
+{
+  struct MS8607_raw_sample raw;
+
+  out->temperature = 0;
+  out->pressure = 0;
+  out->humidity = 0;
+  out->timestamp = 0;
+  out->sequence = 0;
+  out->channels = 0;
+  if (!_present[index] || _busy[index])
+    return (false);
+
+  //getResult_raw() tells which channels were acquired, and does no bus
+  //transaction once the acquisition is finished
+  sensor_type &sensor = _sensors[index];
+  if ((sensor.getResult_raw(&raw) != MS8607_status_ok) ||
+      (sensor.getResult_fixed(&out->temperature, &out->pressure,
+                              &out->humidity) != MS8607_status_ok))
+    return (false);
+
+  out->timestamp = _completed[index];
+  out->sequence = sensor.getSampleSequence();
+  out->channels = raw.channels;
+
+  return (true);
+}
+
+template <uint8_t N, class Bus>
+void MS8607_Manager<N, Bus>::wait_next_step(void)
+{
+  uint32_t wait = getMicrosToNextStep();
+
+  //The rest of a long wait is done on the next call
+  if (wait >= 1000)
+    delay(wait / 1000);
+  else if (wait > 0)
+    delayMicroseconds(wait);
+}
+
+template <uint8_t N, class Bus>
+void MS8607_Manager<N, Bus>::sort_route(void)
+{
+  //Insertion sort on (mux address, channel)
+  for (uint8_t i = 0; i < N; i++)
+  {
+    uint8_t index = i;
+    uint16_t key = ((uint16_t)_sensors[i].bus().mux_address() << 8) | _sensors[i].bus().channel();
+    uint8_t j = i;
+
+    for (; j > 0; j--)
+    {
+      const MS8607_MuxBusT<Bus> &previous = _sensors[_order[j - 1]].bus();
+      if ((((uint16_t)previous.mux_address() << 8) | previous.channel()) <= key)
+        break;
+      _order[j] = _order[j - 1];
+    }
+    _order[j] = index;
+  }
+}
+
+template <uint8_t N, class Bus>
+void MS8607_Manager<N, Bus>::sweep_from_route(void)
+{
+  const MS8607_MuxBusT<Bus> &first = _sensors[_order[0]].bus();
+  const MS8607_MuxBusT<Bus> &last = _sensors[_order[N - 1]].bus();
+
+  //Start at the end the bus is routed to, e.g. after read_all()
+  if (_mux.is_selected(first.mux_address(), first.channel()))
+    _reverse = false;
+  else if (_mux.is_selected(last.mux_address(), last.channel()))
+    _reverse = true;
+}
+
+template <uint8_t N, class Bus>
+uint8_t MS8607_Manager<N, Bus>::sweep_index(uint8_t step)
+{
+  return _order[_reverse ? (N - 1 - step) : step];
+}
+
+#endif
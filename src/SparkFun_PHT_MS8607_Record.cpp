@@ -0,0 +1,270 @@
+#include "SparkFun_PHT_MS8607_Record.h"
+#include "SparkFun_PHT_MS8607_CRC.h"
+
+// MS8607_channel bits, in the order the values are coded
+#define RECORD_TEMPERATURE 0x02
+#define RECORD_PRESSURE 0x01
+#define RECORD_HUMIDITY 0x04
+#define RECORD_CHANNELS 0x07
+
+#define RECORD_KEYFRAME 0x01
+#define RECORD_COEFF_WORDS 7
+
+static uint32_t zigzag(int32_t value)
+{
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t unzigzag(uint32_t value)
+{
+  return (int32_t)((value >> 1) ^ (0 - (value & 1)));
+}
+
+static uint8_t put_varint(uint8_t *out, uint32_t value)
+{
+  uint8_t n = 0;
+
+  while (value >= 0x80)
+  {
+    out[n++] = (uint8_t)value | 0x80;
+    value >>= 7;
+  }
+  out[n++] = (uint8_t)value;
+  return n;
+}
+
+// Returns the number of bytes read, 0 if the buffer ends first, -1 if the
+// varint is longer than 5 bytes
+static int get_varint(const uint8_t *in, size_t length, uint32_t *value)
+{
+  uint32_t result = 0;
+  size_t i;
+
+  for (i = 0; i < 5; i++)
+  {
+    if (i == length)
+      return 0;
+    result |= (uint32_t)(in[i] & 0x7F) << (7 * i);
+    if (!(in[i] & 0x80))
+    {
+      *value = result;
+      return i + 1;
+    }
+  }
+  return -1;
+}
+
+// A keyframe candidate found by scanning is only accepted with the CRC-4 of
+// its PROM words, as the driver checks the PROM, and its check byte
+static bool coeff_valid(const uint16_t *coeff)
+{
+#ifdef MS8607_CRC_NIBBLE_TABLES
+  return MS8607_crc4_nibble(coeff) == (coeff[0] >> 12);
+#else
+  return MS8607_crc4(coeff) == (coeff[0] >> 12);
+#endif
+}
+
+// Check byte of a keyframe: the CRC-8 of the humidity die over every byte
+// before it
+static uint8_t keyframe_check(const uint8_t *keyframe, uint8_t length)
+{
+#ifdef MS8607_CRC_NIBBLE_TABLES
+  return MS8607_crc8_nibble(keyframe, length);
+#else
+  return MS8607_crc8(keyframe, length);
+#endif
+}
+
+// Difference modulo 2^32, so that every int32_t value round-trips
+static int32_t wrap_sub(int32_t a, int32_t b)
+{
+  return (int32_t)((uint32_t)a - (uint32_t)b);
+}
+
+static int32_t wrap_add(int32_t a, int32_t b)
+{
+  return (int32_t)((uint32_t)a + (uint32_t)b);
+}
+
+static uint8_t put_values(uint8_t *out, const struct MS8607_record *record,
+                          const struct MS8607_record *base)
+{
+  uint8_t n = 0;
+
+  if (record->channels & RECORD_TEMPERATURE)
+    n += put_varint(out + n, zigzag(wrap_sub(record->temperature, base->temperature)));
+  if (record->channels & RECORD_PRESSURE)
+    n += put_varint(out + n, zigzag(wrap_sub(record->pressure, base->pressure)));
+  if (record->channels & RECORD_HUMIDITY)
+    n += put_varint(out + n, zigzag(wrap_sub(record->humidity, base->humidity)));
+  return n;
+}
+
+static void codec_reset(struct MS8607_record_codec *codec)
+{
+  static const struct MS8607_record zero = {0, 0, 0, 0, 0, false};
+
+  codec->last = zero;
+  codec->interval = 0;
+  codec->count = 0;
+  codec->synced = false;
+}
+
+void MS8607_record_encoder_init(struct MS8607_record_codec *codec,
+                                const uint16_t *coeff, uint16_t keyframe_interval)
+{
+  uint8_t i;
+
+  for (i = 0; i < RECORD_COEFF_WORDS; i++)
+    codec->coeff[i] = coeff[i];
+  codec->keyframe_interval = keyframe_interval;
+  codec_reset(codec);
+}
+
+void MS8607_record_keyframe(struct MS8607_record_codec *codec)
+{
+  codec->synced = false;
+}
+
+uint8_t MS8607_record_encode(struct MS8607_record_codec *codec,
+                             const struct MS8607_record *record, uint8_t *out)
+{
+  static const struct MS8607_record zero = {0, 0, 0, 0, 0, false};
+  uint32_t interval = record->timestamp - codec->last.timestamp;
+  int32_t change = wrap_sub((int32_t)interval, (int32_t)codec->interval);
+  uint8_t channels = record->channels & RECORD_CHANNELS;
+  uint8_t n, i;
+
+  if (!codec->synced || (channels != codec->last.channels) ||
+      ((codec->keyframe_interval != 0) && (codec->count >= codec->keyframe_interval)) ||
+      (change >= (1L << 30)) || (change < -(1L << 30)))
+  {
+    n = put_varint(out, RECORD_KEYFRAME);
+    out[n++] = channels;
+    for (i = 0; i < RECORD_COEFF_WORDS; i++)
+    {
+      out[n++] = (uint8_t)codec->coeff[i];
+      out[n++] = (uint8_t)(codec->coeff[i] >> 8);
+    }
+    n += put_varint(out + n, record->timestamp);
+    n += put_values(out + n, record, &zero);
+    out[n] = keyframe_check(out, n);
+    n++;
+
+    codec->interval = 0;
+    codec->count = 0;
+    codec->synced = true;
+  }
+  else
+  {
+    n = put_varint(out, zigzag(change) << 1);
+    n += put_values(out + n, record, &codec->last);
+
+    codec->interval = interval;
+    codec->count++;
+  }
+
+  codec->last = *record;
+  codec->last.channels = channels;
+  return n;
+}
+
+void MS8607_record_decoder_init(struct MS8607_record_codec *codec)
+{
+  uint8_t i;
+
+  for (i = 0; i < RECORD_COEFF_WORDS; i++)
+    codec->coeff[i] = 0;
+  codec->keyframe_interval = 0;
+  codec_reset(codec);
+}
+
+int MS8607_record_decode(struct MS8607_record_codec *codec, const uint8_t *in,
+                         size_t length, struct MS8607_record *record)
+{
+  static const uint8_t order[3] = {RECORD_TEMPERATURE, RECORD_PRESSURE,
+                                   RECORD_HUMIDITY};
+  struct MS8607_record decoded;
+  uint16_t coeff[RECORD_COEFF_WORDS];
+  uint32_t header, value, interval = 0;
+  size_t n;
+  int used;
+  uint8_t i;
+
+  used = get_varint(in, length, &header);
+  if (used <= 0)
+    return used;
+  n = used;
+
+  if (header & RECORD_KEYFRAME)
+  {
+    if ((header != RECORD_KEYFRAME) || (length < n + 1 + 2 * RECORD_COEFF_WORDS))
+      return (header != RECORD_KEYFRAME) ? -1 : 0;
+
+    decoded.channels = in[n++];
+    if (decoded.channels & ~RECORD_CHANNELS)
+      return -1;
+    for (i = 0; i < RECORD_COEFF_WORDS; i++, n += 2)
+      coeff[i] = in[n] | ((uint16_t)in[n + 1] << 8);
+    if (!coeff_valid(coeff))
+      return -1;
+
+    used = get_varint(in + n, length - n, &decoded.timestamp);
+    if (used <= 0)
+      return used;
+    n += used;
+
+    decoded.temperature = decoded.pressure = decoded.humidity = 0;
+    decoded.keyframe = true;
+  }
+  else
+  {
+    if (!codec->synced)
+      return -1;
+
+    interval = codec->interval + unzigzag(header >> 1);
+    decoded = codec->last;
+    decoded.timestamp += interval;
+    decoded.keyframe = false;
+  }
+
+  for (i = 0; i < 3; i++)
+  {
+    if (!(decoded.channels & order[i]))
+      continue;
+
+    used = get_varint(in + n, length - n, &value);
+    if (used <= 0)
+      return used;
+    n += used;
+
+    if (order[i] == RECORD_TEMPERATURE)
+      decoded.temperature = wrap_add(decoded.temperature, unzigzag(value));
+    else if (order[i] == RECORD_PRESSURE)
+      decoded.pressure = wrap_add(decoded.pressure, unzigzag(value));
+    else
+      decoded.humidity = wrap_add(decoded.humidity, unzigzag(value));
+  }
+
+  if (decoded.keyframe)
+  {
+    if (n == length)
+      return 0;
+    if (in[n] != keyframe_check(in, n))
+      return -1;
+    n++;
+
+    for (i = 0; i < RECORD_COEFF_WORDS; i++)
+      codec->coeff[i] = coeff[i];
+    codec->count = 0;
+    codec->synced = true;
+  }
+  else
+    codec->count++;
+  codec->interval = interval;
+  codec->last = decoded;
+  *record = decoded;
+
+  return n;
+}
@@ -0,0 +1,133 @@
+/*
+  Compact binary log records for the MS8607.
+
+  A log is a stream of records holding integer samples (0.01 degC, Pa and
+  0.01 %RH, as returned by the _fixed API of the driver):
+    - keyframe : the PROM coefficients, the absolute timestamp and the
+      absolute values. A decoder can start at any keyframe (see below).
+    - delta : the change of every value since the previous record, and the
+      change of the sampling interval (so a steady rate costs nothing).
+  Every number is a zig-zag varint: small positive and negative deltas take
+  a single byte, so a delta record of a slowly changing P/T/RH sample is
+  usually 4 bytes instead of the ~30 bytes of a CSV line.
+
+  Record layout (little endian varints, 7 bits per byte, MSB = more bytes):
+    header   : varint (zigzag(interval change) << 1) | keyframe
+    keyframe : header = 1, channels (1 byte), PROM words 0 to 6 (2 bytes
+               each, LSB first), timestamp (varint), zigzag(value) for
+               each channel: temperature, pressure, humidity, then a check
+               byte: the CRC-8 of the humidity die (see MS8607_crc8()) over
+               all the bytes of the keyframe before it
+    delta    : header, then zigzag(value change) for each channel of the
+               last keyframe
+
+  Resynchronising (e.g. after a torn flash page): a keyframe has no sync
+  marker, so a decoder scans byte by byte and only accepts a candidate
+  whose header is exactly 1, channels byte at most 7, PROM words 0 to 6
+  carry a valid CRC-4 (the top nibble of word 0, as on the device) and
+  check byte matches. Delta records of small changes often hold the bytes
+  0x01, 0x00..0x07: the CRC-4 alone lets 1 of 16 such candidates through,
+  with the check byte 1 of 4096. The PROM given to the encoder must be the
+  one read from the device (or all zero), or every keyframe is rejected.
+  Delta records carry no check: a decoder that is still synced reads the
+  bytes after a tear as deltas until a record is invalid, so decode pages
+  that can be torn on their own.
+
+  The encoder writes a keyframe every keyframe_interval records, when the
+  channels change, when the interval changes by 2^30 ms or more, and after
+  MS8607_record_keyframe() (e.g. at the start of every flash page).
+  The values are coded modulo 2^32, so every int32_t value round-trips.
+
+  MIT License, see SparkFun_PHT_MS8607_Arduino_Library.h
+*/
+
+#ifndef MS8607_RECORD_H
+#define MS8607_RECORD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Largest record: 1 + 1 + 14 + 5 + 3 * 5 + 1 bytes (a keyframe)
+#define MS8607_RECORD_MAX_SIZE 37
+
+// One sample of the log
+struct MS8607_record
+{
+       int32_t temperature; // 0.01 degC
+       int32_t pressure;    // Pa (0.01 mbar)
+       int32_t humidity;    // 0.01 %RH
+       uint32_t timestamp;  // ms
+       uint8_t channels;    // MS8607_channel bits held by the record
+       bool keyframe;       // Decoded from a keyframe
+};
+
+// State of an encoder or a decoder: the previous record and the PROM
+struct MS8607_record_codec
+{
+       struct MS8607_record last;
+       uint32_t interval;          // Timestamp change of the last record
+       uint16_t coeff[7];          // PROM words 0 to 6
+       uint16_t keyframe_interval; // Records between keyframes (encoder)
+       uint16_t count;             // Records since the last keyframe
+       bool synced;                // A keyframe has been coded
+};
+
+/*
+  \brief Start a log. The first record will be a keyframe.
+
+  \param[out] MS8607_record_codec* : Encoder state
+  \param[in] const uint16_t* : PROM words 0 to 6 (see get_prom_coefficients()),
+         with their CRC-4 in the top nibble of word 0
+  \param[in] uint16_t : Write a keyframe at least every n records (0 = only
+         the first one)
+*/
+void MS8607_record_encoder_init(struct MS8607_record_codec *codec,
+                                const uint16_t *coeff, uint16_t keyframe_interval);
+
+/*
+  \brief Make the next record a keyframe, e.g. at the start of a new flash
+         page so that the page can be decoded on its own.
+
+  \param[in,out] MS8607_record_codec* : Encoder state
+*/
+void MS8607_record_keyframe(struct MS8607_record_codec *codec);
+
+/*
+  \brief Encode a sample.
+
+  \param[in,out] MS8607_record_codec* : Encoder state
+  \param[in] const MS8607_record* : Sample (keyframe is ignored)
+  \param[out] uint8_t* : Record, at least MS8607_RECORD_MAX_SIZE bytes
+
+  \return uint8_t : Size of the record in bytes
+*/
+uint8_t MS8607_record_encode(struct MS8607_record_codec *codec,
+                             const struct MS8607_record *record, uint8_t *out);
+
+/*
+  \brief Start decoding a log. Records before the first keyframe are
+         rejected.
+
+  \param[out] MS8607_record_codec* : Decoder state
+*/
+void MS8607_record_decoder_init(struct MS8607_record_codec *codec);
+
+/*
+  \brief Decode the record at the start of a buffer. A keyframe also updates
+         codec->coeff.
+
+  \param[in,out] MS8607_record_codec* : Decoder state
+  \param[in] const uint8_t* : Bytes of the log
+  \param[in] size_t : Number of bytes available
+  \param[out] MS8607_record* : Sample
+
+  \return int : Number of bytes used by the record, 0 if the buffer ends
+         within the record (call again with more bytes), -1 if the record is
+         invalid (e.g. a keyframe whose PROM fails the CRC-4) or no keyframe
+         has been decoded yet (the decoder state is unchanged, skip to the
+         next keyframe)
+*/
+int MS8607_record_decode(struct MS8607_record_codec *codec, const uint8_t *in,
+                         size_t length, struct MS8607_record *record);
+
+#endif